@@ -30,6 +30,14 @@
  */
 void kernel_init(void);
 
+/**
+ * @brief   Puts the CPU to sleep until the next interrupt
+ *
+ * Called over and over by the idle thread. The default implementation calls
+ * pm_set_lowest(); modules may replace it, e.g. `xtimer_tickless`.
+ */
+void kernel_idle(void);
+
 #ifdef __cplusplus
 }
 #endif
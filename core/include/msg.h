@@ -309,6 +309,59 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Send several messages (blocking).
+ *
+ * Delivers the messages in @p m to @p target_pid in order, as if
+ * msg_send() was called for each of them, but with interrupts disabled only
+ * once and waking up the receiver at most once for all messages that fit into
+ * its message queue. If the queue is full, the caller blocks on the next
+ * message until the receiver took it, exactly like msg_send() would, and then
+ * continues with the remaining messages.
+ *
+ * If called from an interrupt or for the calling thread itself, this function
+ * will never block.
+ *
+ * @param[in] m             Array of @p num messages, must not be NULL.
+ *                          ``sender_pid`` is set for each of them.
+ * @param[in] num           Number of messages in @p m.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  number of messages sent, less than @p num only if the function
+ *          must not block and the receiver's queue is full
+ * @return  -1, on error (invalid PID)
+ */
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
+/**
+ * @brief Send several messages (non-blocking).
+ *
+ * Like msg_send_bulk(), but sends only as many messages as the receiver can
+ * take right now.
+ *
+ * @param[in] m             Array of @p num messages, must not be NULL.
+ * @param[in] num           Number of messages in @p m.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  number of messages sent
+ * @return  -1, on error (invalid PID)
+ */
+int msg_try_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
+/**
+ * @brief Receive several messages.
+ *
+ * Blocks until at least one message was received and then takes up to
+ * @p num messages from the message queue and from threads blocked sending to
+ * the calling thread, oldest first, with interrupts disabled only once.
+ *
+ * @param[out] m    Array of at least @p num messages, must not be NULL.
+ * @param[in] num   Maximum number of messages to receive, must be > 0.
+ *
+ * @return  number of messages received (1 to @p num)
+ */
+int msg_receive_bulk(msg_t *m, unsigned num);
+
 /**
  * @brief Send a message, block until reply received.
  *
@@ -13,6 +13,22 @@
  * @ingroup     core
  * @{
  *
+ * Priority inheritance
+ * ====================
+ *
+ * With the `core_mutex_pi` module, a mutex records the thread holding it.
+ * When a thread of higher priority blocks on the mutex, the owner inherits
+ * that priority until it unlocks the mutex, so threads of intermediate
+ * priority can no longer starve the waiting thread (priority inversion). If
+ * the owner is itself blocked on another mutex, the priority is passed on
+ * along the chain of owners.
+ *
+ * Whenever a mutex is unlocked or a waiter gives up on it (e.g. in
+ * xtimer_mutex_lock_timeout()), the priority of its owner is recomputed from
+ * the thread's own priority and the waiters of the mutexes it still holds.
+ * Mutexes initialized with @ref MUTEX_INIT_LOCKED or locked from interrupt
+ * context have no owner and are not subject to priority inheritance.
+ *
  * @file
  * @brief       RIOT synchronization API
  *
@@ -24,6 +40,7 @@
 
 #include <stddef.h>
 
+#include "kernel_types.h"
 #include "list.h"
 
 #ifdef __cplusplus
@@ -40,18 +57,35 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+    /**
+     * @brief   The thread holding the mutex, KERNEL_PID_UNDEF if unknown
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Entry in the list of mutexes held by the owner
+     * @internal
+     */
+    list_node_t held;
+#endif
 } mutex_t;
 
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
-#define MUTEX_INIT { { NULL } }
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, { NULL } }
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, { NULL } }
+#else
+#define MUTEX_INIT { { NULL } }
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -72,6 +106,9 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PI
+    mutex->owner = KERNEL_PID_UNDEF;
+#endif
 }
 
 /**
@@ -127,6 +164,20 @@ void mutex_unlock(mutex_t *mutex);
  */
 void mutex_unlock_and_sleep(mutex_t *mutex);
 
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+/**
+ * @brief Recomputes the priority of the owner of @p mutex
+ *
+ * @internal
+ *
+ * Has to be called after a waiter was removed from the queue of @p mutex by
+ * other means than mutex_unlock(), e.g. on a timeout.
+ *
+ * @param[in] mutex Mutex object the waiter left, must not be NULL.
+ */
+void mutex_pi_update(mutex_t *mutex);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
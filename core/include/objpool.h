@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Pool of fixed-size blocks
+ *
+ * @details Hands out the blocks of a statically allocated array, e.g. of
+ *          table entries or buffers. Allocated blocks are tracked in a
+ *          bitmap next to the array, so the blocks themselves are left
+ *          untouched while free and allocation takes the lowest free block
+ *          in constant time per bitmap word. All functions may be called from
+ *          interrupt context.
+ *
+ *          Every pool counts its allocated blocks, the maximum number of
+ *          blocks allocated at once and failed allocations, which helps to
+ *          dimension it.
+ *
+ *          ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ *          static entry_t _entries[ENTRY_NUMOF];
+ *          static unsigned _entries_used[OBJPOOL_BITMAP_NUMOF(ENTRY_NUMOF)];
+ *          static objpool_t _pool = OBJPOOL_INIT(_entries, _entries_used);
+ *          ~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+
+#ifndef OBJPOOL_H
+#define OBJPOOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of bits in a bitmap word
+ */
+#define OBJPOOL_BITMAP_BITS         (8 * sizeof(unsigned))
+
+/**
+ * @brief   Number of `unsigned` words the bitmap of a pool of @p numof blocks
+ *          needs
+ */
+#define OBJPOOL_BITMAP_NUMOF(numof) (((numof) + OBJPOOL_BITMAP_BITS - 1) / \
+                                     OBJPOOL_BITMAP_BITS)
+
+/**
+ * @brief   Static initializer for a pool over the array @p blocks
+ *
+ * @param[in] blocks    array of blocks
+ * @param[in] used      zero-initialized `unsigned` array of
+ *                      `OBJPOOL_BITMAP_NUMOF(<number of blocks>)` words
+ */
+#define OBJPOOL_INIT(blocks, used) { (uint8_t *)(blocks), (used), \
+                                     sizeof((blocks)[0]), \
+                                     sizeof(blocks) / sizeof((blocks)[0]), \
+                                     0, 0, 0 }
+
+/**
+ * @brief   Pool of fixed-size blocks
+ *
+ * The counters may be read directly but must not be written.
+ */
+typedef struct {
+    uint8_t *blocks;        /**< array of blocks */
+    unsigned *used;         /**< bitmap, a set bit marks an allocated block */
+    size_t size;            /**< size of a block in bytes */
+    uint16_t numof;         /**< number of blocks */
+    uint16_t count;         /**< number of currently allocated blocks */
+    uint16_t count_max;     /**< maximum number of blocks allocated at once */
+    uint16_t fails;         /**< number of failed allocations (saturating) */
+} objpool_t;
+
+/**
+ * @brief   Initializes a pool at run time
+ *
+ * All blocks are free afterwards and the counters are reset.
+ *
+ * @param[out] pool     the pool
+ * @param[in] blocks    array of @p numof blocks of @p size bytes
+ * @param[in] size      size of a block in bytes
+ * @param[in] numof     number of blocks
+ * @param[in] used      array of `OBJPOOL_BITMAP_NUMOF(numof)` words
+ */
+void objpool_init(objpool_t *pool, void *blocks, size_t size, unsigned numof,
+                  unsigned *used);
+
+/**
+ * @brief   Allocates the free block with the lowest position in the array
+ *
+ * The block is not cleared.
+ *
+ * @param[in,out] pool  the pool
+ *
+ * @return  the block
+ * @return  NULL, if all blocks are allocated
+ */
+void *objpool_alloc(objpool_t *pool);
+
+/**
+ * @brief   Marks a given block as allocated
+ *
+ * For users that (re-)use a block they found by other means than
+ * objpool_alloc(), e.g. an entry they still know the content of.
+ *
+ * @param[in,out] pool  the pool
+ * @param[in] block     a block of @p pool
+ *
+ * @return  true, if @p block was free
+ * @return  false, if @p block was already allocated
+ */
+bool objpool_take(objpool_t *pool, void *block);
+
+/**
+ * @brief   Returns a block to the pool
+ *
+ * @pre     @p block is allocated
+ *
+ * @param[in,out] pool  the pool
+ * @param[in] block     a block of @p pool
+ */
+void objpool_free(objpool_t *pool, void *block);
+
+/**
+ * @brief   Checks if a block is allocated
+ *
+ * @param[in] pool      the pool
+ * @param[in] block     a block of @p pool
+ *
+ * @return  true, if @p block is allocated
+ */
+bool objpool_is_used(const objpool_t *pool, const void *block);
+
+/**
+ * @brief   Returns the position of a block in the array of a pool
+ *
+ * @param[in] pool      the pool
+ * @param[in] block     a block of @p pool
+ *
+ * @return  position of @p block
+ */
+static inline unsigned objpool_index(const objpool_t *pool, const void *block)
+{
+    return ((const uint8_t *)block - pool->blocks) / pool->size;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OBJPOOL_H */
+/** @} */
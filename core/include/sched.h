@@ -133,6 +133,21 @@ void sched_set_status(thread_t *process, unsigned int status);
  */
 void sched_switch(uint16_t other_prio);
 
+/**
+ * @brief       Change the priority of a thread
+ *
+ * @details     If the thread is on a runqueue, it is moved to the front of the
+ *              runqueue of its new priority, so the active thread stays the
+ *              head of its runqueue. This function does not yield, callers
+ *              have to call sched_switch() or thread_yield_higher() if the
+ *              change requires a context switch.
+ *
+ * @param[in]   thread      The thread to change the priority of
+ * @param[in]   priority    The new priority of the thread, must be lower
+ *                          than @ref SCHED_PRIO_LEVELS
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief   Call context switching at thread exit
  */
@@ -188,9 +188,10 @@ struct _thread {
     clist_node_t rq_entry;          /**< run queue entry                */
 
 #if defined(MODULE_CORE_MSG) || defined(MODULE_CORE_THREAD_FLAGS) \
-    || defined(MODULE_CORE_MBOX) || defined(DOXYGEN)
-    void *wait_data;                /**< used by msg, mbox and thread
-                                         flags                          */
+    || defined(MODULE_CORE_MBOX) || defined(MODULE_CORE_MUTEX_PI) \
+    || defined(DOXYGEN)
+    void *wait_data;                /**< used by msg, mbox, thread flags
+                                         and priority inheriting mutexes */
 #endif
 #if defined(MODULE_CORE_MSG) || defined(DOXYGEN)
     list_node_t msg_waiters;        /**< threads waiting for their message
@@ -202,9 +203,19 @@ struct _thread {
                                          to this thread's message queue */
 #endif
 #if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
-    || defined(MODULE_MPU_STACK_GUARD) || defined(DOXYGEN)
+    || defined(MODULE_MPU_STACK_GUARD) || defined(MODULE_CORE_STACK_HWM) \
+    || defined(DOXYGEN)
     char *stack_start;              /**< thread's stack start address   */
 #endif
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+    uint8_t base_priority;          /**< priority without inherited ones */
+    list_node_t held_mutexes;       /**< priority inheriting mutexes the
+                                         thread holds                   */
+#endif
+#if defined(MODULE_CORE_STACK_HWM) || defined(DOXYGEN)
+    char *stack_hwm;                /**< lowest stack address known to
+                                         have been used                 */
+#endif
 #if defined(DEVELHELP) || defined(DOXYGEN)
     const char *name;               /**< thread's name                  */
     int stack_size;                 /**< thread's stack size            */
@@ -316,6 +327,22 @@ struct _thread {
 #define THREAD_CREATE_STACKTEST         (8)
 /** @} */
 
+/**
+ * @brief   Number of stack words scanned per context switch for the stack
+ *          high-water mark
+ *
+ * With the `core_stack_hwm` module, every thread's stack is filled with
+ * markers on creation. Whenever a thread is switched out, the scheduler
+ * lowers its high-water mark to its stack pointer and then moves it further
+ * down over overwritten markers until it found this many untouched ones in a
+ * row. Deep call chains are thus picked up without ever scanning a whole
+ * stack at once; gaps larger than the window (e.g. big, sparsely used
+ * buffers on the stack) are only found by thread_measure_stack_free().
+ */
+#ifndef THREAD_STACK_HWM_WINDOW
+#define THREAD_STACK_HWM_WINDOW         (8U)
+#endif
+
 /**
  * @brief Creates a new thread.
  *
@@ -472,6 +499,33 @@ const char *thread_getname(kernel_pid_t pid);
 uintptr_t thread_measure_stack_free(char *stack);
 #endif /* DEVELHELP */
 
+#if defined(MODULE_CORE_STACK_HWM) || defined(DOXYGEN)
+/**
+ * @brief   Update the stack high-water mark of a thread
+ *
+ * Called by the scheduler with interrupts disabled for the thread being
+ * switched out.
+ *
+ * @param[in] thread    thread to update the high-water mark of
+ */
+void thread_stack_hwm_update(thread_t *thread);
+
+/**
+ * @brief   Get the stack space a thread did not use so far
+ *
+ * Unlike thread_measure_stack_free(), this does not scan the stack but
+ * returns what has been tracked up to the thread's last context switch (see
+ * @ref THREAD_STACK_HWM_WINDOW). Usage in between switches or beyond the
+ * scan window is missed, so the result may exceed the actual free space.
+ *
+ * @param[in] pid   PID of the thread
+ *
+ * @return  number of bytes at the bottom of the stack not known to be used
+ * @return  -1, if there is no thread with @p pid
+ */
+int thread_stack_hwm_free(kernel_pid_t pid);
+#endif
+
 /**
  * @brief   Get the number of bytes used on the ISR stack
  */
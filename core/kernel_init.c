@@ -60,12 +60,17 @@ static void *main_trampoline(void *arg)
     return NULL;
 }
 
+void __attribute__((weak)) kernel_idle(void)
+{
+    pm_set_lowest();
+}
+
 static void *idle_thread(void *arg)
 {
     (void) arg;
 
     while (1) {
-        pm_set_lowest();
+        kernel_idle();
     }
 
     return NULL;
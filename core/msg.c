@@ -217,6 +217,97 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 }
 
+/* delivers as many of the num messages in m as target can take right now,
+ * must be called with interrupts disabled */
+static unsigned _deliver(thread_t *target, const msg_t *m, unsigned num)
+{
+    unsigned n = 0;
+
+    if ((num > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        /* target's queue is empty if it is waiting, so the first message
+         * goes directly to it and the others are queued behind it */
+        *((msg_t *)target->wait_data) = m[n++];
+        sched_set_status(target, STATUS_PENDING);
+    }
+    for (; n < num; n++) {
+        int index = cib_put(&target->msg_queue);
+
+        if (index < 0) {
+            break;
+        }
+        target->msg_array[index] = m[n];
+    }
+#if MODULE_CORE_THREAD_FLAGS
+    if (n > 0) {
+        target->flags |= THREAD_FLAG_MSG_WAITING;
+        thread_flags_wake(target);
+    }
+#endif
+    return n;
+}
+
+static int _msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid,
+                          bool block)
+{
+    kernel_pid_t sender_pid = sched_active_pid;
+    unsigned sent = 0;
+
+    if (irq_is_in()) {
+        sender_pid = KERNEL_PID_ISR;
+        block = false;
+    }
+    else if (sched_active_pid == target_pid) {
+        block = false;
+    }
+    for (unsigned i = 0; i < num; i++) {
+        m[i].sender_pid = sender_pid;
+    }
+
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *)sched_threads[target_pid];
+
+    while (target != NULL) {
+        sent += _deliver(target, &m[sent], num - sent);
+        if ((sent == num) || !block) {
+            break;
+        }
+        /* queue is full: block on the next message until the receiver took
+         * it, then queue the remaining ones again at once */
+        if (_msg_send(&m[sent], target_pid, true, state) < 0) {
+            return (sent > 0) ? (int)sent : -1;
+        }
+        sent++;
+        state = irq_disable();
+        target = (thread_t *)sched_threads[target_pid];
+    }
+    if (target == NULL) {
+        DEBUG("msg_send_bulk(): target thread does not exist\n");
+        irq_restore(state);
+        return (sent > 0) ? (int)sent : -1;
+    }
+
+    uint16_t target_prio = THREAD_PRIORITY_IDLE;
+    if ((target != sched_active_thread) &&
+        (target->status >= STATUS_ON_RUNQUEUE)) {
+        target_prio = target->priority;
+    }
+    irq_restore(state);
+    if (target_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(target_prio);
+    }
+    return (int)sent;
+}
+
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+    return _msg_send_bulk(m, num, target_pid, true);
+}
+
+int msg_try_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+    return _msg_send_bulk(m, num, target_pid, false);
+}
+
 int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
 {
     assert(sched_active_pid != target_pid);
@@ -372,6 +463,79 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+/* takes up to num messages from the queue and from blocked senders of me,
+ * must be called with interrupts disabled */
+static unsigned _take(thread_t *me, msg_t *m, unsigned num,
+                      uint16_t *sender_prio)
+{
+    unsigned n = 0;
+
+    while (n < num) {
+        int index = cib_get(&me->msg_queue);
+
+        if (index < 0) {
+            break;
+        }
+        m[n++] = me->msg_array[index];
+    }
+    /* messages of blocked senders are younger than the queued ones, so they
+     * either follow them in m (if the queue is drained now) or refill the
+     * queue slots just freed */
+    while (me->msg_waiters.next != NULL) {
+        msg_t *dest;
+
+        if (n < num) {
+            dest = &m[n++];
+        }
+        else {
+            int index = cib_put(&me->msg_queue);
+
+            if (index < 0) {
+                break;
+            }
+            dest = &me->msg_array[index];
+        }
+
+        list_node_t *next = list_remove_head(&me->msg_waiters);
+        thread_t *sender = container_of((clist_node_t *)next, thread_t,
+                                        rq_entry);
+
+        *dest = *((msg_t *)sender->wait_data);
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < *sender_prio) {
+                *sender_prio = sender->priority;
+            }
+        }
+    }
+    return n;
+}
+
+int msg_receive_bulk(msg_t *m, unsigned num)
+{
+    assert(num > 0);
+
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    thread_t *me = (thread_t *)sched_active_thread;
+    unsigned state = irq_disable();
+    unsigned n = _take(me, m, num, &sender_prio);
+
+    irq_restore(state);
+    if (n == 0) {
+        /* nothing there yet: block for the first one, then take what else
+         * has been queued in the meantime */
+        _msg_receive(m, 1);
+        state = irq_disable();
+        n = 1 + _take(me, &m[1], num - 1, &sender_prio);
+        irq_restore(state);
+    }
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return (int)n;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
@@ -32,6 +32,107 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_CORE_MUTEX_PI
+static inline void _pi_take(mutex_t *mutex, thread_t *thread)
+{
+    mutex->owner = thread->pid;
+    list_add(&thread->held_mutexes, &mutex->held);
+}
+
+/* effective priority: the thread's own one or the one of the most important
+ * waiter of any mutex it holds, whichever is higher */
+static uint8_t _pi_priority(thread_t *thread)
+{
+    uint8_t priority = thread->base_priority;
+
+    for (list_node_t *node = thread->held_mutexes.next; node;
+         node = node->next) {
+        mutex_t *mutex = container_of(node, mutex_t, held);
+        list_node_t *head = mutex->queue.next;
+        /* the waiting queue is sorted, so its head has the highest priority */
+        if (head && (head != MUTEX_LOCKED)) {
+            thread_t *waiter = container_of((clist_node_t *)head, thread_t,
+                                            rq_entry);
+            if (waiter->priority < priority) {
+                priority = waiter->priority;
+            }
+        }
+    }
+    return priority;
+}
+
+/* returns 1 if the active thread was lowered in priority */
+static int _pi_update(thread_t *thread)
+{
+    int lowered = 0;
+
+    /* follow the chain of owners that are themselves blocked on a mutex */
+    while (thread) {
+        uint8_t priority = _pi_priority(thread);
+        if (priority == thread->priority) {
+            break;
+        }
+        DEBUG("PID[%" PRIkernel_pid "]: owner %" PRIkernel_pid " changes to "
+              "prio %u\n", sched_active_pid, thread->pid, (unsigned)priority);
+        if ((thread == sched_active_thread) && (priority > thread->priority)) {
+            lowered = 1;
+        }
+        sched_change_priority(thread, priority);
+        if (thread->status != STATUS_MUTEX_BLOCKED) {
+            break;
+        }
+        /* keep the owner's position in the waiting queue sorted */
+        mutex_t *mutex = thread->wait_data;
+        list_remove(&mutex->queue, (list_node_t *)&thread->rq_entry);
+        thread_add_to_list(&mutex->queue, thread);
+        thread = (thread_t *)thread_get(mutex->owner);
+    }
+    return lowered;
+}
+
+static inline void _pi_boost(mutex_t *mutex)
+{
+    _pi_update((thread_t *)thread_get(mutex->owner));
+}
+
+/* returns 1 if the active thread was lowered in priority */
+static int _pi_release(mutex_t *mutex)
+{
+    thread_t *owner = (thread_t *)thread_get(mutex->owner);
+
+    mutex->owner = KERNEL_PID_UNDEF;
+    if (!owner) {
+        return 0;
+    }
+    list_remove(&owner->held_mutexes, &mutex->held);
+    return _pi_update(owner);
+}
+
+void mutex_pi_update(mutex_t *mutex)
+{
+    unsigned irqstate = irq_disable();
+    _pi_update((thread_t *)thread_get(mutex->owner));
+    irq_restore(irqstate);
+}
+#else
+static inline void _pi_take(mutex_t *mutex, thread_t *thread)
+{
+    (void)mutex;
+    (void)thread;
+}
+
+static inline void _pi_boost(mutex_t *mutex)
+{
+    (void)mutex;
+}
+
+static inline int _pi_release(mutex_t *mutex)
+{
+    (void)mutex;
+    return 0;
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -41,6 +142,10 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        /* in interrupt context, there is no owner to boost */
+        if (!irq_is_in()) {
+            _pi_take(mutex, (thread_t *)sched_active_thread);
+        }
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -58,6 +163,10 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+#ifdef MODULE_CORE_MUTEX_PI
+        me->wait_data = mutex;
+#endif
+        _pi_boost(mutex);
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -86,7 +195,12 @@ void mutex_unlock(mutex_t *mutex)
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
+        int lowered = _pi_release(mutex);
         irq_restore(irqstate);
+        if (lowered) {
+            /* a thread we were preempting on behalf of a waiter may run */
+            sched_switch(0);
+        }
         return;
     }
 
@@ -103,6 +217,13 @@ void mutex_unlock(mutex_t *mutex)
     }
 
     uint16_t process_priority = process->priority;
+    if (_pi_release(mutex)) {
+        /* we lost an inherited priority, let the scheduler decide */
+        process_priority = 0;
+    }
+    /* the new owner is the waiter of highest priority, so the remaining ones
+     * need no boost */
+    _pi_take(mutex, process);
     irq_restore(irqstate);
     sched_switch(process_priority);
 }
@@ -116,6 +237,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     if (mutex->queue.next) {
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
+            _pi_release(mutex);
         }
         else {
             list_node_t *next = list_remove_head(&mutex->queue);
@@ -126,6 +248,8 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
+            _pi_release(mutex);
+            _pi_take(mutex, process);
         }
     }
 
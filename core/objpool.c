@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Pool of fixed-size blocks implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "irq.h"
+#include "objpool.h"
+
+void objpool_init(objpool_t *pool, void *blocks, size_t size, unsigned numof,
+                  unsigned *used)
+{
+    pool->blocks = blocks;
+    pool->used = used;
+    pool->size = size;
+    pool->numof = numof;
+    pool->count = 0;
+    pool->count_max = 0;
+    pool->fails = 0;
+    memset(used, 0, OBJPOOL_BITMAP_NUMOF(numof) * sizeof(unsigned));
+}
+
+static void _mark_used(objpool_t *pool, unsigned index)
+{
+    pool->used[index / OBJPOOL_BITMAP_BITS] |= 1U << (index %
+                                                      OBJPOOL_BITMAP_BITS);
+    if (++pool->count > pool->count_max) {
+        pool->count_max = pool->count;
+    }
+}
+
+void *objpool_alloc(objpool_t *pool)
+{
+    unsigned state = irq_disable();
+
+    for (unsigned i = 0; i < OBJPOOL_BITMAP_NUMOF(pool->numof); i++) {
+        unsigned free = ~pool->used[i];
+
+        if (free != 0) {
+            /* isolate the lowest free bit, its MSB is its position */
+            unsigned index = (i * OBJPOOL_BITMAP_BITS) +
+                             bitarithm_msb(free & (~free + 1));
+
+            /* bits beyond the last block are never set */
+            if (index >= pool->numof) {
+                break;
+            }
+            _mark_used(pool, index);
+            irq_restore(state);
+            return pool->blocks + (index * pool->size);
+        }
+    }
+    if (pool->fails < UINT16_MAX) {
+        pool->fails++;
+    }
+    irq_restore(state);
+    return NULL;
+}
+
+bool objpool_take(objpool_t *pool, void *block)
+{
+    unsigned index = objpool_index(pool, block);
+    bool res = false;
+
+    assert(index < pool->numof);
+    unsigned state = irq_disable();
+    if (!objpool_is_used(pool, block)) {
+        _mark_used(pool, index);
+        res = true;
+    }
+    irq_restore(state);
+    return res;
+}
+
+void objpool_free(objpool_t *pool, void *block)
+{
+    unsigned index = objpool_index(pool, block);
+
+    assert(index < pool->numof);
+    unsigned state = irq_disable();
+    assert(objpool_is_used(pool, block));
+    pool->used[index / OBJPOOL_BITMAP_BITS] &= ~(1U << (index %
+                                                        OBJPOOL_BITMAP_BITS));
+    pool->count--;
+    irq_restore(state);
+}
+
+bool objpool_is_used(const objpool_t *pool, const void *block)
+{
+    unsigned index = objpool_index(pool, block);
+
+    return (pool->used[index / OBJPOOL_BITMAP_BITS] &
+            (1U << (index % OBJPOOL_BITMAP_BITS))) != 0;
+}
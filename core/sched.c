@@ -33,10 +33,14 @@
 #include "mpu.h"
 #endif
 
-#ifdef MODULE_SCHEDSTATISTICS
+#if defined(MODULE_SCHEDSTATISTICS) || defined(MODULE_SCHED_PROFILE)
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_SCHED_PROFILE
+#include "sched_profile.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -100,7 +104,7 @@ int __attribute__((used)) sched_run(void)
         return 0;
     }
 
-#ifdef MODULE_SCHEDSTATISTICS
+#if defined(MODULE_SCHEDSTATISTICS) || defined(MODULE_SCHED_PROFILE)
     uint32_t now = xtimer_now().ticks32;
 #endif
 
@@ -115,6 +119,10 @@ int __attribute__((used)) sched_run(void)
         }
 #endif
 
+#ifdef MODULE_CORE_STACK_HWM
+        thread_stack_hwm_update(active_thread);
+#endif
+
 #ifdef MODULE_SCHEDSTATISTICS
         schedstat *active_stat = &sched_pidlist[active_thread->pid];
         if (active_stat->laststart) {
@@ -131,6 +139,9 @@ int __attribute__((used)) sched_run(void)
         sched_cb(now, next_thread->pid);
     }
 #endif
+#ifdef MODULE_SCHED_PROFILE
+    sched_profile_switch(next_thread, now);
+#endif
 
     next_thread->status = STATUS_RUNNING;
     sched_active_pid = next_thread->pid;
@@ -160,6 +171,9 @@ void sched_register_cb(void (*callback)(uint32_t, uint32_t))
 
 void sched_set_status(thread_t *process, unsigned int status)
 {
+#ifdef MODULE_SCHED_PROFILE
+    sched_profile_status(process, status);
+#endif
     if (status >= STATUS_ON_RUNQUEUE) {
         if (!(process->status >= STATUS_ON_RUNQUEUE)) {
             DEBUG("sched_set_status: adding thread %" PRIkernel_pid " to runqueue %" PRIu16 ".\n",
@@ -208,6 +222,32 @@ void sched_switch(uint16_t other_prio)
     }
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    unsigned irqstate = irq_disable();
+
+    if (thread->priority == priority) {
+        irq_restore(irqstate);
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid " from %" PRIu16
+          " to %" PRIu16 ".\n", thread->pid, (uint16_t)thread->priority,
+          (uint16_t)priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        if (!sched_runqueues[thread->priority].next) {
+            runqueue_bitcache &= ~(1 << thread->priority);
+        }
+        clist_lpush(&sched_runqueues[priority], &thread->rq_entry);
+        runqueue_bitcache |= 1 << priority;
+    }
+    thread->priority = priority;
+
+    irq_restore(irqstate);
+}
+
 NORETURN void sched_task_exit(void)
 {
     DEBUG("sched_task_exit: ending thread %" PRIkernel_pid "...\n", sched_active_thread->pid);
@@ -143,6 +143,48 @@ uintptr_t thread_measure_stack_free(char *stack)
 }
 #endif
 
+#ifdef MODULE_CORE_STACK_HWM
+void thread_stack_hwm_update(thread_t *thread)
+{
+    uintptr_t *start = (uintptr_t *)thread->stack_start;
+    uintptr_t *hwm = (uintptr_t *)thread->stack_hwm;
+    uintptr_t *sp = (uintptr_t *)((uintptr_t)thread->sp &
+                                  ~(uintptr_t)(sizeof(uintptr_t) - 1));
+
+    /* the stack pointer is a lower bound for what has been used so far */
+    if ((sp >= start) && (sp < hwm)) {
+        hwm = sp;
+    }
+    /* words below that only still hold their marker if never used, stop
+     * after a window of untouched words: as the mark only ever moves down,
+     * this costs THREAD_STACK_HWM_WINDOW words per switch amortized */
+    uintptr_t *word = hwm;
+    unsigned untouched = 0;
+
+    while ((untouched < THREAD_STACK_HWM_WINDOW) && (word > start)) {
+        word--;
+        if (*word != (uintptr_t)word) {
+            hwm = word;
+            untouched = 0;
+        }
+        else {
+            untouched++;
+        }
+    }
+    thread->stack_hwm = (char *)hwm;
+}
+
+int thread_stack_hwm_free(kernel_pid_t pid)
+{
+    thread_t *thread = (thread_t *)thread_get(pid);
+
+    if (thread == NULL) {
+        return -1;
+    }
+    return thread->stack_hwm - thread->stack_start;
+}
+#endif
+
 kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags, thread_task_func_t function, void *arg, const char *name)
 {
     if (priority >= SCHED_PRIO_LEVELS) {
@@ -175,7 +217,13 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     /* allocate our thread control block at the top of our stackspace */
     thread_t *cb = (thread_t *) (stack + stacksize);
 
-#if defined(DEVELHELP) || defined(SCHED_TEST_STACK)
+#ifdef MODULE_CORE_STACK_HWM
+    /* high-water marks are tracked for all threads */
+    flags |= THREAD_CREATE_STACKTEST;
+#endif
+
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
+    || defined(MODULE_CORE_STACK_HWM)
     if (flags & THREAD_CREATE_STACKTEST) {
         /* assign each int of the stack the value of it's address */
         uintptr_t *stackmax = (uintptr_t *) (stack + stacksize);
@@ -214,9 +262,13 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cb->pid = pid;
     cb->sp = thread_stack_init(function, arg, stack, stacksize);
 
-#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || defined(MODULE_MPU_STACK_GUARD)
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
+    || defined(MODULE_MPU_STACK_GUARD) || defined(MODULE_CORE_STACK_HWM)
     cb->stack_start = stack;
 #endif
+#ifdef MODULE_CORE_STACK_HWM
+    cb->stack_hwm = (char *)cb;
+#endif
 
 #ifdef DEVELHELP
     cb->stack_size = total_stacksize;
@@ -225,6 +277,10 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
 
     cb->priority = priority;
     cb->status = 0;
+#ifdef MODULE_CORE_MUTEX_PI
+    cb->base_priority = priority;
+    cb->held_mutexes.next = NULL;
+#endif
 
     cb->rq_entry.next = NULL;
 
@@ -22,6 +22,9 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include "async_read.h"
 #include "native_internal.h"
@@ -36,6 +39,22 @@ static pid_t _sigio_child_pids[ASYNC_READ_NUMOF];
 static void _sigio_child(int fd);
 #endif
 
+#ifdef __linux__
+static int _epoll_fd = -1;
+
+static void _async_io_isr(void) {
+    struct epoll_event events[ASYNC_READ_NUMOF];
+    int num;
+
+    /* signals do not queue, so handle every ready descriptor per SIGIO */
+    num = epoll_wait(_epoll_fd, events, ASYNC_READ_NUMOF, 0);
+    for (int i = 0; i < num; i++) {
+        int index = events[i].data.u32;
+
+        _native_async_read_callbacks[index](_fds[index], _args[index]);
+    }
+}
+#else
 static void _async_io_isr(void) {
     fd_set rfds;
 
@@ -61,8 +80,17 @@ static void _async_io_isr(void) {
         }
     }
 }
+#endif
 
 void native_async_read_setup(void) {
+#ifdef __linux__
+    if (_epoll_fd == -1) {
+        _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll_fd == -1) {
+            err(EXIT_FAILURE, "native_async_read_setup(): epoll_create1");
+        }
+    }
+#endif
     register_interrupt(SIGIO, _async_io_isr);
 }
 
@@ -75,6 +103,12 @@ void native_async_read_cleanup(void) {
 #endif
         real_close(_fds[i]);
     }
+#ifdef __linux__
+    if (_epoll_fd != -1) {
+        real_close(_epoll_fd);
+        _epoll_fd = -1;
+    }
+#endif
 }
 
 void native_async_read_continue(int fd) {
@@ -111,6 +145,16 @@ void native_async_read_add_handler(int fd, void *arg, native_async_read_callback
         err(EXIT_FAILURE, "native_async_read_add_handler(): fcntl(F_SETFL)");
     }
 #endif /* not OSX */
+#ifdef __linux__
+    struct epoll_event event = {
+        .events = EPOLLIN,
+        .data.u32 = _next_index,
+    };
+
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): epoll_ctl");
+    }
+#endif
 
     _next_index++;
 }
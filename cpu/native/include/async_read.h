@@ -24,6 +24,10 @@ extern "C" {
 
 /**
  * @brief   Maximum number of file descriptors
+ *
+ * On Linux, descriptors are watched with epoll, so unlike with `select()`
+ * their values are not limited by `FD_SETSIZE`. All descriptors that are
+ * ready when SIGIO is handled get their callback called.
  */
 #ifndef ASYNC_READ_NUMOF
 #define ASYNC_READ_NUMOF 2
@@ -12,6 +12,19 @@
  * @{
  * @brief       mtd flash emulation for native
  *
+ * The backing file is mapped into memory on init, so reads and writes are
+ * plain memory accesses. Pages written since the last flush are tracked and
+ * written back to the file by mtd_native_flush() or when the device is
+ * powered down.
+ *
+ * Like real NOR flash, programming can only clear bits, setting them again
+ * requires erasing the sector. With @ref MTD_NATIVE_FLAG_STRICT, writes that
+ * would set a bit fail instead of silently keeping it cleared.
+ *
+ * For flash wear simulations, the number of erases per sector is counted and
+ * sectors can be given a limited endurance. Program and erase operations can
+ * be made to fail half way, as they would on a power loss.
+ *
  * @file
  *
  * @author      Vincent Dupont <vincent@otakeys.com>
@@ -20,16 +33,29 @@
 #ifndef MTD_NATIVE_H
 #define MTD_NATIVE_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #include "mtd.h"
 
+/**
+ * @brief   Fail writes that would set a bit that is not erased with -EIO
+ */
+#define MTD_NATIVE_FLAG_STRICT      (0x01)
+
 /** mtd native descriptor */
 typedef struct mtd_native_dev {
     mtd_dev_t dev;      /**< mtd generic device */
     const char *fname;  /**< filename to use for memory emulation */
+    uint32_t endurance; /**< erase cycles a sector survives, 0 for unlimited */
+    uint8_t flags;      /**< MTD_NATIVE_FLAG_* */
+    uint8_t *mem;       /**< mapping of the file, set on init */
+    uint8_t *dirty;     /**< bitmap of pages written since the last flush */
+    uint32_t *wear;     /**< erase count per sector */
+    uint32_t fault;     /**< program or erase operations until a fault */
 } mtd_native_dev_t;
 
 /**
@@ -37,6 +63,45 @@ typedef struct mtd_native_dev {
  */
 extern const mtd_desc_t native_flash_driver;
 
+/**
+ * @brief   Write pages changed since the last flush back to the file
+ *
+ * @param[in] dev   initialized device
+ *
+ * @return  0 on success
+ * @return  -EIO if the file could not be written
+ */
+int mtd_native_flush(mtd_native_dev_t *dev);
+
+/**
+ * @brief   Get the number of times a sector was erased
+ *
+ * @param[in] dev       initialized device
+ * @param[in] sector    sector number
+ *
+ * @return  erase count of @p sector
+ */
+static inline uint32_t mtd_native_wear(const mtd_native_dev_t *dev,
+                                       uint32_t sector)
+{
+    return dev->wear[sector];
+}
+
+/**
+ * @brief   Inject a fault into a future program or erase operation
+ *
+ * The @p ops-th program or erase operation from now is only carried out on
+ * the first half of its range and then fails with -EIO, like an operation
+ * interrupted by a power loss.
+ *
+ * @param[in] dev   device
+ * @param[in] ops   operation to fail, 1 for the next one, 0 to cancel
+ */
+static inline void mtd_native_inject_fault(mtd_native_dev_t *dev, uint32_t ops)
+{
+    dev->fault = ops;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,7 @@
 #endif // BSD/Linux
 #include <netdb.h>
 #include <ifaddrs.h>
+#include <poll.h>
 #include <time.h>
 #include <sys/time.h>
 #include <sys/stat.h>
@@ -113,6 +114,7 @@ extern int (*real_listen)(int socket, int backlog);
 extern int (*real_open)(const char *path, int oflag, ...);
 extern int (*real_pause)(void);
 extern int (*real_pipe)(int[2]);
+extern int (*real_poll)(struct pollfd *fds, nfds_t nfds, int timeout);
 /* The ... is a hack to save includes: */
 extern int (*real_select)(int nfds, ...);
 extern int (*real_setitimer)(int which, const struct itimerval
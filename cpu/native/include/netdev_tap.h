@@ -35,6 +35,16 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of frames received per interrupt
+ *
+ * Frames that arrived while the stack was busy are received in one go,
+ * instead of raising an interrupt for every one of them.
+ */
+#ifndef NETDEV_TAP_RX_BATCH
+#define NETDEV_TAP_RX_BATCH         (8U)
+#endif
+
 /**
  * @brief tap interface state
  */
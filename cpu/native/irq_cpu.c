@@ -41,6 +41,10 @@
 
 #include "native_internal.h"
 
+#ifdef MODULE_SCHED_PROFILE
+#include "sched_profile.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -261,7 +265,13 @@ void native_irq_handler(void)
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+#ifdef MODULE_SCHED_PROFILE
+            sched_profile_isr_enter();
+#endif
             native_irq_handlers[sig]();
+#ifdef MODULE_SCHED_PROFILE
+            sched_profile_isr_exit();
+#endif
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
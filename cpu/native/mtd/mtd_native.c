@@ -16,9 +16,15 @@
  */
 
 #include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
 #include <assert.h>
 #include <inttypes.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "mtd.h"
 #include "mtd_native.h"
@@ -28,49 +34,96 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+static inline size_t _size(const mtd_dev_t *dev)
+{
+    return dev->sector_count * dev->pages_per_sector * dev->page_size;
+}
+
+static inline size_t _sector_size(const mtd_dev_t *dev)
+{
+    return dev->pages_per_sector * dev->page_size;
+}
+
+/* counts down to an injected fault, returns true if this operation fails */
+static bool _fault(mtd_native_dev_t *dev)
+{
+    return (dev->fault != 0) && (--dev->fault == 0);
+}
+
 static int _init(mtd_dev_t *dev)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t size = _size(dev);
+    uint32_t pages = dev->sector_count * dev->pages_per_sector;
+    struct stat st;
+    void *mem;
 
     DEBUG("mtd_native: init, filename=%s\n", _dev->fname);
 
-    FILE *f = real_fopen(_dev->fname, "r");
+    if (_dev->mem) {
+        return 0;
+    }
 
-    if (!f) {
-        DEBUG("mtd_native: init: creating file %s\n", _dev->fname);
-        f = real_fopen(_dev->fname, "w+");
-        if (!f) {
-            return -EIO;
-        }
-        size_t size = dev->sector_count * dev->pages_per_sector * dev->page_size;
-        for (size_t i = 0; i < size; i++) {
-            real_fputc(0xff, f);
-        }
+    _native_syscall_enter();
+    int fd = real_open(_dev->fname, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        _native_syscall_leave();
+        return -EIO;
+    }
+    if ((fstat(fd, &st) < 0) ||
+        (((size_t)st.st_size < size) && (ftruncate(fd, size) < 0))) {
+        real_close(fd);
+        _native_syscall_leave();
+        return -EIO;
     }
+    mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    real_close(fd);
+    if (mem == MAP_FAILED) {
+        _native_syscall_leave();
+        return -EIO;
+    }
+    _dev->dirty = real_calloc((pages + 7) / 8, 1);
+    _dev->wear = real_calloc(dev->sector_count, sizeof(uint32_t));
+    if (!_dev->dirty || !_dev->wear) {
+        real_free(_dev->dirty);
+        real_free(_dev->wear);
+        munmap(mem, size);
+        _native_syscall_leave();
+        return -ENOMEM;
+    }
+    _native_syscall_leave();
 
-    real_fclose(f);
+    if ((size_t)st.st_size < size) {
+        DEBUG("mtd_native: init: erasing %u new bytes of %s\n",
+              (unsigned)(size - st.st_size), _dev->fname);
+        memset((uint8_t *)mem + st.st_size, 0xff, size - st.st_size);
+    }
+    _dev->mem = mem;
 
     return 0;
 }
 
+static void _mark_dirty(mtd_native_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    uint32_t page_size = dev->dev.page_size;
+
+    for (uint32_t page = addr / page_size; page <= (addr + size - 1) / page_size;
+         page++) {
+        dev->dirty[page / 8] |= (1 << (page % 8));
+    }
+}
+
 static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
 
     DEBUG("mtd_native: read from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
 
-    if (addr + size > mtd_size) {
+    if (addr + size > _size(dev)) {
         return -EOVERFLOW;
     }
 
-    FILE *f = real_fopen(_dev->fname, "r");
-    if (!f) {
-        return -EIO;
-    }
-    real_fseek(f, addr, SEEK_SET);
-    size = real_fread(buff, 1, size, f);
-    real_fclose(f);
+    memcpy(buff, _dev->mem + addr, size);
 
     return size;
 }
@@ -78,67 +131,131 @@ static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
 static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
-    size_t sector_size = dev->pages_per_sector * dev->page_size;
+    size_t sector_size = _sector_size(dev);
+    const uint8_t *src = buff;
+    uint8_t *dst = _dev->mem + addr;
+    int res = size;
 
     DEBUG("mtd_native: write from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
 
-    if (addr + size > mtd_size) {
+    if (addr + size > _size(dev)) {
         return -EOVERFLOW;
     }
     if (((addr % sector_size) + size) > sector_size) {
         return -EOVERFLOW;
     }
+    if (size == 0) {
+        return 0;
+    }
 
-    FILE *f = real_fopen(_dev->fname, "r+");
-    if (!f) {
-        return -EIO;
+    if (_dev->flags & MTD_NATIVE_FLAG_STRICT) {
+        for (size_t i = 0; i < size; i++) {
+            if (src[i] & ~dst[i]) {
+                DEBUG("mtd_native: write: 0x%" PRIx32 " is not erased\n",
+                      (uint32_t)(addr + i));
+                return -EIO;
+            }
+        }
     }
-    real_fseek(f, addr, SEEK_SET);
+    if (_fault(_dev)) {
+        DEBUG("mtd_native: write: injected fault\n");
+        size /= 2;
+        res = -EIO;
+    }
+    /* programming can only clear bits */
     for (size_t i = 0; i < size; i++) {
-        uint8_t c = real_fgetc(f);
-        real_fseek(f, -1, SEEK_CUR);
-        real_fputc(c & ((uint8_t*)buff)[i], f);
+        dst[i] &= src[i];
+    }
+    if (size) {
+        _mark_dirty(_dev, addr, size);
     }
-    real_fclose(f);
 
-    return size;
+    return res;
 }
 
 static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
-    size_t sector_size = dev->pages_per_sector * dev->page_size;
+    size_t sector_size = _sector_size(dev);
+    int res = 0;
 
     DEBUG("mtd_native: erase from sector %" PRIu32 " count %" PRIu32 "\n", addr, size);
 
-    if (addr + size > mtd_size) {
+    if (addr + size > _size(dev)) {
         return -EOVERFLOW;
     }
     if (((addr % sector_size) != 0) || ((size % sector_size) != 0)) {
         return -EOVERFLOW;
     }
 
-    FILE *f = real_fopen(_dev->fname, "r+");
-    if (!f) {
-        return -EIO;
+    if (_fault(_dev)) {
+        DEBUG("mtd_native: erase: injected fault\n");
+        size /= 2;
+        res = -EIO;
     }
-    real_fseek(f, addr, SEEK_SET);
-    for (size_t i = 0; i < size; i++) {
-        real_fputc(0xff, f);
+    for (uint32_t offset = 0; offset < size; offset += sector_size) {
+        uint32_t sector = (addr + offset) / sector_size;
+        uint32_t len = ((size - offset) < sector_size) ? (size - offset)
+                                                       : sector_size;
+
+        if (_dev->endurance && (_dev->wear[sector] >= _dev->endurance)) {
+            DEBUG("mtd_native: erase: sector %" PRIu32 " worn out\n", sector);
+            return -EIO;
+        }
+        _dev->wear[sector]++;
+        memset(_dev->mem + addr + offset, 0xff, len);
+        _mark_dirty(_dev, addr + offset, len);
     }
-    real_fclose(f);
 
-    return 0;
+    return res;
+}
+
+int mtd_native_flush(mtd_native_dev_t *dev)
+{
+    uint32_t pages = dev->dev.sector_count * dev->dev.pages_per_sector;
+    uint32_t page_size = dev->dev.page_size;
+    int res = 0;
+
+    if (!dev->mem) {
+        return 0;
+    }
+
+    _native_syscall_enter();
+    size_t host_page = sysconf(_SC_PAGESIZE);
+    for (uint32_t page = 0; page < pages;) {
+        uint32_t first;
+
+        if (dev->dirty[page / 8] == 0) {
+            page = (page + 8) & ~7U;
+            continue;
+        }
+        if (!(dev->dirty[page / 8] & (1 << (page % 8)))) {
+            page++;
+            continue;
+        }
+        /* sync the whole run of dirty pages at once */
+        first = page;
+        while ((page < pages) && (dev->dirty[page / 8] & (1 << (page % 8)))) {
+            dev->dirty[page / 8] &= ~(1 << (page % 8));
+            page++;
+        }
+        size_t start = (first * page_size) & ~(host_page - 1);
+        if (msync(dev->mem + start, (page * page_size) - start, MS_SYNC) < 0) {
+            res = -EIO;
+        }
+    }
+    _native_syscall_leave();
+
+    return res;
 }
 
 static int _power(mtd_dev_t *dev, enum mtd_power_state power)
 {
-    (void) dev;
-    (void) power;
+    if (power == MTD_POWER_DOWN) {
+        return mtd_native_flush((mtd_native_dev_t *)dev);
+    }
 
-    return -ENOTSUP;
+    return 0;
 }
 
 
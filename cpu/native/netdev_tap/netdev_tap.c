@@ -25,6 +25,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 
@@ -92,10 +93,20 @@ static inline int _set_promiscous(netdev_t *netdev, int value)
     return value;
 }
 
+static bool _readable(netdev_tap_t *dev);
+static void _continue_reading(netdev_tap_t *dev);
+
 static inline void _isr(netdev_t *netdev)
 {
     if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        netdev_tap_t *dev = (netdev_tap_t*)netdev;
+        unsigned frames = 0;
+
+        /* receive up to NETDEV_TAP_RX_BATCH frames per interrupt */
+        do {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        } while ((++frames < NETDEV_TAP_RX_BATCH) && _readable(dev));
+        _continue_reading(dev);
     }
 #if DEVELHELP
     else {
@@ -173,18 +184,26 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
+static bool _readable(netdev_tap_t *dev)
+{
+    struct pollfd pfd = { .fd = dev->tap_fd, .events = POLLIN };
+    int res;
+
+    _native_in_syscall++; /* no switching here */
+    res = real_poll(&pfd, 1, 0);
+    _native_in_syscall--;
+
+    return res == 1;
+}
+
 static void _continue_reading(netdev_tap_t *dev)
 {
     /* work around lost signals */
-    fd_set rfds;
-    struct timeval t;
-    memset(&t, 0, sizeof(t));
-    FD_ZERO(&rfds);
-    FD_SET(dev->tap_fd, &rfds);
+    bool readable = _readable(dev);
 
     _native_in_syscall++; /* no switching here */
 
-    if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
+    if (readable) {
         int sig = SIGIO;
         extern int _sig_pipefd[2];
         extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
@@ -221,8 +240,6 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
             static uint8_t buf[ETHERNET_FRAME_LEN];
 
             real_read(dev->tap_fd, buf, sizeof(buf));
-
-            _continue_reading(dev);
         }
 
         /* no way of figuring out packet size without racey buffering,
@@ -243,13 +260,9 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
                   hdr->dst[0], hdr->dst[1], hdr->dst[2],
                   hdr->dst[3], hdr->dst[4], hdr->dst[5]);
 
-            native_async_read_continue(dev->tap_fd);
-
             return 0;
         }
 
-        _continue_reading(dev);
-
 #ifdef MODULE_NETSTATS_L2
         netdev->stats.rx_count++;
         netdev->stats.rx_bytes += nread;
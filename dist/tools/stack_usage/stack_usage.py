@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Lists the largest stack frames of a build.
+
+Reads the `.su` files written by the compiler when building with
+`STACK_USAGE=1` (`-fstack-usage`) and prints the largest frames and the
+largest frame per module. Together with the high-water marks tracked by the
+`core_stack_hwm` module this helps to find out which functions make up the
+stack size a thread needs.
+"""
+
+import argparse
+import os
+import sys
+
+
+def read_frames(bindir):
+    frames = []
+    for root, _, files in os.walk(bindir):
+        for name in files:
+            if not name.endswith(".su"):
+                continue
+            module = os.path.relpath(root, bindir)
+            with open(os.path.join(root, name)) as su:
+                for line in su:
+                    # <file>:<line>:<column>:<function>\t<bytes>\t<qualifiers>
+                    fields = line.rstrip("\n").split("\t")
+                    if len(fields) != 3:
+                        continue
+                    location, size, qualifiers = fields
+                    function = location.rsplit(":", 1)[-1]
+                    frames.append((int(size), qualifiers, module, function))
+    return frames
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("bindir", help="BINDIR of the application")
+    parser.add_argument("-n", "--limit", type=int, default=20,
+                        help="number of functions to list (default: 20)")
+    args = parser.parse_args()
+
+    frames = read_frames(args.bindir)
+    if not frames:
+        sys.exit("No stack usage information found in %s, rebuild with "
+                 "STACK_USAGE=1" % args.bindir)
+
+    frames.sort(reverse=True)
+    print("Largest stack frames:")
+    print("%8s  %-16s  %-24s  %s" % ("bytes", "qualifiers", "module",
+                                     "function"))
+    for size, qualifiers, module, function in frames[:args.limit]:
+        print("%8d  %-16s  %-24s  %s" % (size, qualifiers, module, function))
+
+    largest = {}
+    for frame in frames:
+        if frame[2] not in largest:
+            largest[frame[2]] = frame
+    print()
+    print("Largest stack frame per module:")
+    print("%8s  %-24s  %s" % ("bytes", "module", "function"))
+    for size, _, module, function in sorted(largest.values(), reverse=True):
+        print("%8d  %-24s  %s" % (size, module, function))
+    if any("dynamic" in frame[1] for frame in frames):
+        print()
+        print("Note: frames marked \"dynamic\" use alloca() or variable length "
+              "arrays, their size is a lower bound.")
+
+
+if __name__ == "__main__":
+    main()
@@ -54,6 +54,12 @@ ifeq ($(LTO),1)
   LINKFLAGS += ${LTOFLAGS}
 endif
 
+# Write the stack frame size of every function to a .su file next to its
+# object file, `make info-stack-usage` lists the largest ones.
+ifeq ($(STACK_USAGE),1)
+  CFLAGS += -fstack-usage
+endif
+
 # Forbid common symbols to prevent accidental aliasing.
 CFLAGS += -fno-common
 
@@ -1,6 +1,6 @@
 .PHONY: info-objsize info-buildsizes info-build info-boards-supported \
         info-features-missing info-modules info-cpu \
-        info-features-provided info-features-required
+        info-features-provided info-features-required info-stack-usage
 
 info-objsize:
 	@case "${SORTROW}" in \
@@ -20,6 +20,9 @@ info-objsize:
 info-buildsize:
 	@$(SIZE) -d -B $(BINDIR)/$(APPLICATION).elf || echo ''
 
+info-stack-usage:
+	@$(RIOTBASE)/dist/tools/stack_usage/stack_usage.py $(BINDIR)
+
 info-build:
 	@echo 'APPLICATION: $(APPLICATION)'
 	@echo ''
@@ -178,4 +178,14 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
                           (struct _sock_tl_ep *)remote, NETCONN_RAW);
 }
 
+ssize_t sock_ip_sendv(sock_ip_t *sock, const struct iovec *vector,
+                      unsigned count, uint8_t proto,
+                      const sock_ip_ep_t *remote)
+{
+    assert((sock != NULL) || (remote != NULL));
+    assert((count == 0) || (vector != NULL));
+    return lwip_sock_sendv(&sock->conn, vector, count, proto,
+                           (struct _sock_tl_ep *)remote, NETCONN_RAW);
+}
+
 /** @} */
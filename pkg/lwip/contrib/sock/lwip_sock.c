@@ -472,12 +472,14 @@ int lwip_sock_recv(struct netconn *conn, uint32_t timeout, struct netbuf **buf)
 }
 #endif /* defined(MODULE_LWIP_SOCK_UDP) || defined(MODULE_LWIP_SOCK_IP) */
 
-ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
-                       int proto, const struct _sock_tl_ep *remote, int type)
+ssize_t lwip_sock_sendv(struct netconn **conn, const struct iovec *vector,
+                        unsigned count, int proto,
+                        const struct _sock_tl_ep *remote, int type)
 {
     ip_addr_t remote_addr;
     struct netconn *tmp;
     struct netbuf *buf;
+    size_t len = 0;
     int res;
     err_t err;
     u16_t remote_port = 0;
@@ -496,12 +498,27 @@ ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
         }
     }
 
+    for (unsigned i = 0; i < count; i++) {
+        len += vector[i].iov_len;
+    }
     buf = netbuf_new();
-    if ((buf == NULL) || (netbuf_alloc(buf, len) == NULL) ||
-        (netbuf_take(buf, data, len) != ERR_OK)) {
+    if ((buf == NULL) || (netbuf_alloc(buf, len) == NULL)) {
         netbuf_delete(buf);
         return -ENOMEM;
     }
+    /* copy every fragment exactly once into the (possibly chained) pbuf */
+    for (unsigned i = 0, offset = 0; i < count; i++) {
+        /* pbuf_take_at() fails for an offset at the end of the pbuf */
+        if (vector[i].iov_len == 0) {
+            continue;
+        }
+        if (pbuf_take_at(buf->p, vector[i].iov_base, vector[i].iov_len,
+                         offset) != ERR_OK) {
+            netbuf_delete(buf);
+            return -ENOMEM;
+        }
+        offset += vector[i].iov_len;
+    }
     if (((conn == NULL) || (*conn == NULL)) && (remote != NULL)) {
         if ((res = _create(type, proto, 0, &tmp)) < 0) {
             netbuf_delete(buf);
@@ -516,6 +533,7 @@ ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
              (remote->netif != SOCK_ADDR_ANY_NETIF) &&
              (netconn_getaddr(*conn, &addr, &port, 1) == 0) &&
              (remote->netif != lwip_sock_bind_addr_to_netif(&addr)))) {
+            netbuf_delete(buf);
             return -EINVAL;
         }
         tmp = *conn;
@@ -530,7 +548,18 @@ ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
     }
 #if LWIP_TCP
     else if (tmp->type & NETCONN_TCP) {
-        err = netconn_write_partly(tmp, data, len, 0, (size_t *)(&res));
+        res = 0;
+        err = ERR_OK;
+        for (unsigned i = 0; (i < count) && (err == ERR_OK); i++) {
+            size_t written = 0;
+
+            err = netconn_write_partly(tmp, vector[i].iov_base,
+                                       vector[i].iov_len, 0, &written);
+            res += written;
+            if (written < vector[i].iov_len) {
+                break;
+            }
+        }
     }
 #endif /* LWIP_TCP */
     else {
@@ -66,22 +66,14 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep)
                                0)) ? -ENOTCONN : 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+static int _recv(sock_udp_t *sock, struct netbuf **buf, uint32_t timeout,
+                 sock_udp_ep_t *remote)
 {
-    uint8_t *data_ptr = data;
-    struct netbuf *buf;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
-    if ((res = lwip_sock_recv(sock->conn, timeout, &buf)) < 0) {
+    if ((res = lwip_sock_recv(sock->conn, timeout, buf)) < 0) {
         return res;
     }
-    res = buf->p->tot_len;
-    if ((unsigned)res > max_len) {
-        netbuf_delete(buf);
-        return -ENOBUFS;
-    }
     if (remote != NULL) {
         /* convert remote */
         size_t addr_len;
@@ -96,20 +88,39 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
             addr_len = sizeof(ipv4_addr_t);
             remote->family = AF_INET;
 #else
-            netbuf_delete(buf);
+            netbuf_delete(*buf);
             return -EPROTO;
 #endif
 #if LWIP_IPV6
         }
 #endif
 #if LWIP_NETBUF_RECVINFO
-        remote->netif = lwip_sock_bind_addr_to_netif(&buf->toaddr);
+        remote->netif = lwip_sock_bind_addr_to_netif(&(*buf)->toaddr);
 #else
         remote->netif = SOCK_ADDR_ANY_NETIF;
 #endif
         /* copy address */
-        memcpy(&remote->addr, &buf->addr, addr_len);
-        remote->port = buf->port;
+        memcpy(&remote->addr, &(*buf)->addr, addr_len);
+        remote->port = (*buf)->port;
+    }
+    return 0;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    uint8_t *data_ptr = data;
+    struct netbuf *buf;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    if ((res = _recv(sock, &buf, timeout, remote)) < 0) {
+        return res;
+    }
+    res = buf->p->tot_len;
+    if ((unsigned)res > max_len) {
+        netbuf_delete(buf);
+        return -ENOBUFS;
     }
     /* copy data */
     for (struct pbuf *q = buf->p; q != NULL; q = q->next) {
@@ -120,6 +131,42 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     return (ssize_t)res;
 }
 
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    struct netbuf *buf;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if ((res = _recv(sock, &buf, timeout, remote)) < 0) {
+        return res;
+    }
+    if (buf->p->next != NULL) {
+        /* data is scattered over multiple pbufs, so it needs to be copied
+         * once to be handed out as a contiguous buffer */
+        struct pbuf *p = pbuf_alloc(PBUF_RAW, buf->p->tot_len, PBUF_RAM);
+
+        if ((p == NULL) || (pbuf_copy(p, buf->p) != ERR_OK)) {
+            if (p != NULL) {
+                pbuf_free(p);
+            }
+            netbuf_delete(buf);
+            return -ENOMEM;
+        }
+        pbuf_free(buf->p);
+        buf->p = p;
+        buf->ptr = p;
+    }
+    *data = buf->p->payload;
+    *buf_ctx = buf;
+    return (ssize_t)buf->p->tot_len;
+}
+
+void sock_udp_recv_buf_free(void *buf_ctx)
+{
+    netbuf_delete(buf_ctx);
+}
+
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote)
 {
@@ -133,4 +180,17 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                           NETCONN_UDP);
 }
 
+ssize_t sock_udp_sendv(sock_udp_t *sock, const struct iovec *vector,
+                       unsigned count, const sock_udp_ep_t *remote)
+{
+    assert((sock != NULL) || (remote != NULL));
+    assert((count == 0) || (vector != NULL));
+
+    if ((remote != NULL) && (remote->port == 0)) {
+        return -EINVAL;
+    }
+    return lwip_sock_sendv(&sock->conn, vector, count, 0,
+                           (struct _sock_tl_ep *)remote, NETCONN_UDP);
+}
+
 /** @} */
@@ -23,6 +23,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <sys/uio.h>
 
 #include "net/af.h"
 #include "net/sock.h"
@@ -55,8 +56,18 @@ int lwip_sock_get_addr(struct netconn *conn, struct _sock_tl_ep *ep, u8_t local)
 #if defined(MODULE_LWIP_SOCK_UDP) || defined(MODULE_LWIP_SOCK_IP)
 int lwip_sock_recv(struct netconn *conn, uint32_t timeout, struct netbuf **buf);
 #endif
-ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
-                       int proto, const struct _sock_tl_ep *remote, int type);
+ssize_t lwip_sock_sendv(struct netconn **conn, const struct iovec *vector,
+                        unsigned count, int proto,
+                        const struct _sock_tl_ep *remote, int type);
+
+static inline ssize_t lwip_sock_send(struct netconn **conn, const void *data,
+                                     size_t len, int proto,
+                                     const struct _sock_tl_ep *remote, int type)
+{
+    const struct iovec vector = { .iov_base = (void *)data, .iov_len = len };
+
+    return lwip_sock_sendv(conn, &vector, 1, proto, remote, type);
+}
 /**
  * @}
  */
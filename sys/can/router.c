@@ -22,13 +22,12 @@
 
 #include "kernel_defines.h"
 
-#include "net/gnrc/pktbuf.h"
-
 #include "can/router.h"
 #include "can/pkt.h"
 #include "can/device.h"
 #include "utlist.h"
 #include "mutex.h"
+#include "objpool.h"
 #include "assert.h"
 
 #ifdef MODULE_CAN_MBOX
@@ -50,7 +49,6 @@ typedef struct filter_el {
     canid_t can_id;          /**< CAN ID of the element */
     canid_t mask;            /**< Mask of the element */
     void *data;              /**< Private data */
-    gnrc_pktsnip_t *snip;    /**< Pointer to the allocated snip */
 } filter_el_t;
 
 /**
@@ -58,6 +56,13 @@ typedef struct filter_el {
  */
 static can_reg_entry_t *table[CAN_DLL_NUMOF];
 
+/**
+ * Pool of filter elements
+ */
+static filter_el_t filter_buf[CAN_ROUTER_MAX_FILTER];
+static unsigned filter_used[OBJPOOL_BITMAP_NUMOF(CAN_ROUTER_MAX_FILTER)];
+static objpool_t filter_pool = OBJPOOL_INIT(filter_buf, filter_used);
+
 
 static mutex_t lock = MUTEX_INIT;
 
@@ -88,19 +93,16 @@ static void _print_filters(void)
 
 static filter_el_t *_alloc_filter_el(canid_t can_id, canid_t mask, void *data)
 {
-    filter_el_t *el;
-    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, NULL, sizeof(*el), GNRC_NETTYPE_UNDEF);
-    if (!snip) {
+    filter_el_t *el = objpool_alloc(&filter_pool);
+    if (!el) {
         DEBUG("can_router: _alloc_canid_el: out of memory\n");
         return NULL;
     }
 
-    el = snip->data;
     el->can_id = can_id;
     el->mask = mask;
     el->data = data;
     el->entry.next = NULL;
-    el->snip = snip;
     DEBUG("_alloc_canid_el: el allocated with can_id=0x%" PRIx32 ", mask=0x%" PRIx32
           ", data=%p\n", can_id, mask, data);
     return el;
@@ -111,7 +113,7 @@ static void _free_filter_el(filter_el_t *el)
     DEBUG("_free_canid_el: el freed with can_id=0x%" PRIx32 ", mask=0x%" PRIx32
           ", data=%p\n", el->can_id, el->mask, el->data);
 
-    gnrc_pktbuf_release(el->snip);
+    objpool_free(&filter_pool, el);
 }
 
 /* Insert to the list in a sorted way
@@ -14,6 +14,10 @@
 #include "clist.h"
 #include "thread.h"
 
+/* terminates the stack of posted events, as a NULL next pointer marks an
+ * event that is not queued */
+static clist_node_t _posted_end;
+
 void event_queue_init(event_queue_t *queue)
 {
     assert(queue);
@@ -21,24 +25,89 @@ void event_queue_init(event_queue_t *queue)
     queue->waiter = (thread_t *)sched_active_thread;
 }
 
+void event_queues_init(event_queue_t *queues, unsigned n_queues)
+{
+    for (unsigned i = 0; i < n_queues; i++) {
+        event_queue_init(&queues[i]);
+    }
+}
+
 void event_post(event_queue_t *queue, event_t *event)
 {
     assert(!event->list_node.next);
     assert(queue->waiter);
 
-    unsigned state = irq_disable();
-    clist_rpush(&queue->event_list, &event->list_node);
-    irq_restore(state);
+    uintptr_t head = atomic_load(&queue->posted);
+
+    do {
+        event->list_node.next = head ? (clist_node_t *)head : &_posted_end;
+    } while (!atomic_compare_exchange_weak(&queue->posted, &head,
+                                           (uintptr_t)&event->list_node));
 
     thread_flags_set(queue->waiter, THREAD_FLAG_EVENT);
 }
 
+/**
+ * @brief   Move all posted events to the end of the event list, in the order
+ *          they were posted
+ *
+ * Must be called with interrupts disabled, so event_cancel() never misses an
+ * event that is on its way.
+ */
+static void _collect(event_queue_t *queue)
+{
+    clist_node_t *node = (clist_node_t *)atomic_exchange(&queue->posted, 0);
+    clist_node_t *first = NULL, *last = NULL;
+
+    if (!node) {
+        return;
+    }
+    /* the stack is newest first, so reverse it */
+    while (node != &_posted_end) {
+        clist_node_t *next = node->next;
+
+        node->next = first;
+        first = node;
+        if (!last) {
+            last = node;
+        }
+        node = next;
+    }
+    if (queue->event_list.next) {
+        last->next = queue->event_list.next->next;
+        queue->event_list.next->next = first;
+    }
+    else {
+        last->next = first;
+    }
+    queue->event_list.next = last;
+}
+
+static inline int _is_empty(event_queue_t *queue)
+{
+    return !queue->event_list.next && !atomic_load(&queue->posted);
+}
+
+static event_t *_pop(event_queue_t *queue)
+{
+    if (!queue->event_list.next) {
+        _collect(queue);
+    }
+    event_t *result = (event_t *) clist_lpop(&queue->event_list);
+
+    if (result) {
+        result->list_node.next = NULL;
+    }
+    return result;
+}
+
 void event_cancel(event_queue_t *queue, event_t *event)
 {
     assert(queue);
     assert(event);
 
     unsigned state = irq_disable();
+    _collect(queue);
     clist_remove(&queue->event_list, &event->list_node);
     event->list_node.next = NULL;
     irq_restore(state);
@@ -47,33 +116,70 @@ void event_cancel(event_queue_t *queue, event_t *event)
 event_t *event_get(event_queue_t *queue)
 {
     unsigned state = irq_disable();
-    event_t *result = (event_t *) clist_lpop(&queue->event_list);
+    event_t *result = _pop(queue);
 
     irq_restore(state);
-    if (result) {
-        result->list_node.next = NULL;
-    }
     return result;
 }
 
-event_t *event_wait(event_queue_t *queue)
+unsigned event_get_batch(event_queue_t *queue, event_t **events, unsigned max)
 {
-    thread_flags_wait_any(THREAD_FLAG_EVENT);
+    unsigned n = 0;
     unsigned state = irq_disable();
-    event_t *result = (event_t *) clist_lpop(&queue->event_list);
-    if (clist_rpeek(&queue->event_list)) {
-        queue->waiter->flags |= THREAD_FLAG_EVENT;
+
+    _collect(queue);
+    while (n < max) {
+        event_t *event = (event_t *) clist_lpop(&queue->event_list);
+
+        if (!event) {
+            break;
+        }
+        event->list_node.next = NULL;
+        events[n++] = event;
     }
     irq_restore(state);
-    result->list_node.next = NULL;
+    return n;
+}
+
+event_t *event_wait_multi(event_queue_t *queues, unsigned n_queues)
+{
+    event_t *result = NULL;
+
+    assert(n_queues > 0);
+    /* the flag may be left over from events taken by event_get() or
+     * event_get_batch(), so wait until there really is an event */
+    do {
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+        unsigned state = irq_disable();
+        for (unsigned i = 0; (i < n_queues) && !result; i++) {
+            result = _pop(&queues[i]);
+        }
+        for (unsigned i = 0; i < n_queues; i++) {
+            if (!_is_empty(&queues[i])) {
+                queues[0].waiter->flags |= THREAD_FLAG_EVENT;
+                break;
+            }
+        }
+        irq_restore(state);
+    } while (!result);
     return result;
 }
 
+event_t *event_wait(event_queue_t *queue)
+{
+    return event_wait_multi(queue, 1);
+}
+
 void event_loop(event_queue_t *queue)
+{
+    event_loop_multi(queue, 1);
+}
+
+void event_loop_multi(event_queue_t *queues, unsigned n_queues)
 {
     event_t *event;
 
-    while ((event = event_wait(queue))) {
+    while ((event = event_wait_multi(queues, n_queues))) {
         event->handler(event);
     }
 }
@@ -29,6 +29,14 @@ extern "C" {
 #include "can/can.h"
 #include "can/pkt.h"
 
+/**
+ * @brief Maximum number of filters registered at the same time, over all
+ *        interfaces
+ */
+#ifndef CAN_ROUTER_MAX_FILTER
+#define CAN_ROUTER_MAX_FILTER   (16)
+#endif
+
 /**
  * @brief Register a user @p entry to receive a frame @p can_id
  *
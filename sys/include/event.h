@@ -41,6 +41,17 @@
  * to be queued. Thus event queues can be used safely and efficiently in combination
  * with thread flags and msg queues.
  *
+ * event_post() is lock-free: events are pushed onto a stack with an atomic
+ * compare-and-swap, which compiles to LDREX/STREX where available and falls
+ * back to disabling interrupts elsewhere. The thread owning the queue moves
+ * all posted events to its FIFO at once, with interrupts disabled for a time
+ * linear to the number of events posted since. event_get_batch() hands out
+ * many events in one call.
+ *
+ * A thread can own several event queues of different priority and wait for
+ * all of them with event_wait_multi(), which always serves the queue with
+ * the lowest index first.
+ *
  * Examples:
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
@@ -89,6 +100,7 @@
 #ifndef EVENT_H
 #define EVENT_H
 
+#include <stdatomic.h>
 #include <stdint.h>
 
 #include "irq.h"
@@ -133,6 +145,7 @@ struct event {
  * @brief   event queue structure
  */
 typedef struct {
+    atomic_uintptr_t posted;    /**< stack of posted events, newest first */
     clist_node_t event_list;    /**< list of queued events              */
     thread_t *waiter;           /**< thread ownning event queue         */
 } event_queue_t;
@@ -146,9 +159,22 @@ typedef struct {
  */
 void event_queue_init(event_queue_t *queue);
 
+/**
+ * @brief   Initialize an array of event queues
+ *
+ * This will set the calling thread as owner of all queues, e.g. to wait for
+ * them with event_wait_multi().
+ *
+ * @param[out]  queues  event queue objects to initialize
+ * @param[in]   n_queues number of queues in @p queues
+ */
+void event_queues_init(event_queue_t *queues, unsigned n_queues);
+
 /**
  * @brief   Queue an event
  *
+ * Can be called from any thread or ISR and never disables interrupts.
+ *
  * @param[in]   queue   event queue to queue event in
  * @param[in]   event   event to queue in event queue
  */
@@ -179,6 +205,20 @@ void event_cancel(event_queue_t *queue, event_t *event);
  */
 event_t *event_get(event_queue_t *queue);
 
+/**
+ * @brief   Get up to @p max events from event queue, non-blocking
+ *
+ * Must only be called by the thread owning @p queue.
+ *
+ * @param[in]   queue   event queue to get events from
+ * @param[out]  events  array to store the events in, in the order they were
+ *                      posted
+ * @param[in]   max     number of elements in @p events
+ *
+ * @returns     number of events stored in @p events
+ */
+unsigned event_get_batch(event_queue_t *queue, event_t **events, unsigned max);
+
 /**
  * @brief   Get next event from event queue, blocking
  *
@@ -193,6 +233,21 @@ event_t *event_get(event_queue_t *queue);
  */
 event_t *event_wait(event_queue_t *queue);
 
+/**
+ * @brief   Get next event from several event queues, blocking
+ *
+ * This function will block until an event becomes available in any of
+ * @p queues. If several queues hold events, the event is taken from the
+ * one with the lowest index, so the index acts as priority.
+ *
+ * @param[in]   queues  event queues to get event from, all owned by the
+ *                      calling thread
+ * @param[in]   n_queues number of queues in @p queues
+ *
+ * @returns     pointer to next event
+ */
+event_t *event_wait_multi(event_queue_t *queues, unsigned n_queues);
+
 /**
  * @brief   Simple event loop
  *
@@ -211,6 +266,17 @@ event_t *event_wait(event_queue_t *queue);
  */
 void event_loop(event_queue_t *queue);
 
+/**
+ * @brief   Simple event loop for several event queues
+ *
+ * Like event_loop(), but handles events of @p queues in the order given by
+ * event_wait_multi().
+ *
+ * @param[in]   queues  event queues to process
+ * @param[in]   n_queues number of queues in @p queues
+ */
+void event_loop_multi(event_queue_t *queues, unsigned n_queues);
+
 #ifdef __cplusplus
 }
 #endif
@@ -92,6 +92,22 @@ typedef struct {
     size_t entry_pool_size;
 } fib_sr_meta_t;
 
+/**
+ * @brief Node of the prefix trie indexing the entries of a single hop FIB table
+ *
+ * The key of an entry is the size of its address (one byte) followed by the
+ * first prefix length bits of the address. Host entries use the full address
+ * and the all zero address (default route) has an empty prefix.
+ */
+typedef struct fib_trie_node {
+    /** sub-tries for the next key bit being 0 or 1 */
+    struct fib_trie_node *child[2];
+    /** next node of an entry with the same key */
+    struct fib_trie_node *next;
+    /** length of the key in bits */
+    uint16_t len;
+} fib_trie_node_t;
+
 /**
 * @brief FIB table type for single hop entries
 */
@@ -133,6 +149,17 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** optional prefix trie over the entries of a single hop table.
+    *   If set, it MUST point to an array of (2 * `size`) nodes, otherwise
+    *   lookups scan the whole table
+    */
+    fib_trie_node_t *trie;
+    /** root of the prefix trie */
+    fib_trie_node_t *trie_root;
+    /** unused branch nodes of the prefix trie */
+    fib_trie_node_t *trie_free;
+    /** earliest point in time an entry of this table expires */
+    uint64_t next_expiry;
 } fib_table_t;
 
 #ifdef __cplusplus
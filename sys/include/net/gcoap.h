@@ -51,6 +51,17 @@
  * gcoap itself defines a resource for `/.well-known/core` discovery, which
  * lists all of the registered paths.
  *
+ * A resource handles requests for its exact path. If GCOAP_MATCH_SUBTREE is
+ * set in its methods, it also handles requests for paths below it. An exact
+ * match takes precedence; otherwise the resource with the longest matching
+ * path wins.
+ *
+ * By default gcoap compares the request path to every resource of every
+ * listener. For servers with many resources, the `gcoap_resource_index`
+ * module instead sorts the resources into an index on registration and finds
+ * the path with a binary search. The index holds GCOAP_RESOURCE_INDEX_SIZE
+ * resources.
+ *
  * ### Creating a response ###
  *
  * An application resource includes a callback function, a coap_handler_t. After
@@ -223,6 +234,27 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Flag in coap_resource_t::methods to also handle requests for paths
+ *          below the resource path
+ *
+ * A resource `/sensors` with this flag matches `/sensors`, `/sensors/temp` and
+ * `/sensors/temp/1`, but not `/sensorsx`.
+ */
+#define GCOAP_MATCH_SUBTREE     (0x8000)
+
+/**
+ * @brief   Number of resources the index of the `gcoap_resource_index` module
+ *          holds, including `/.well-known/core`
+ *
+ * Resources registered once the index is full are still served. However, a
+ * request that does not exactly match an indexed resource then falls back to
+ * the linear search.
+ */
+#ifndef GCOAP_RESOURCE_INDEX_SIZE
+#define GCOAP_RESOURCE_INDEX_SIZE   (32)
+#endif
+
 /**
  * @brief  Size for module message queue
  */
@@ -417,7 +449,8 @@ extern "C" {
  */
 typedef struct gcoap_listener {
     coap_resource_t *resources;     /**< First element in the array of
-                                     *   resources; must order alphabetically */
+                                     *   resources; must order alphabetically,
+                                     *   unless gcoap_resource_index is used */
     size_t resources_len;           /**< Length of array */
     struct gcoap_listener *next;    /**< Next listener in list */
 } gcoap_listener_t;
@@ -27,6 +27,7 @@
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
 #include "net/gnrc/pkt.h"
 
 #ifdef __cplusplus
@@ -79,6 +80,23 @@ gnrc_pktsnip_t *gnrc_icmpv6_error_time_exc_build(uint8_t code, gnrc_pktsnip_t *o
 gnrc_pktsnip_t *gnrc_icmpv6_error_param_prob_build(uint8_t code, void *ptr,
                                                    gnrc_pktsnip_t *orig_pkt);
 
+/**
+ * @brief   Passes an ICMPv6 error message down to IPv6
+ *
+ * @internal
+ *
+ * @param[in] pkt   The ICMPv6 error message.
+ */
+static inline void gnrc_icmpv6_error_pass_down(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    /* there is no IPv6 thread to send to, IPv6 is always registered though */
+    gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL, pkt);
+#else
+    gnrc_netapi_send(gnrc_ipv6_pid, pkt);
+#endif
+}
+
 /**
  * @brief   Sends an ICMPv6 destination unreachable message for sending.
  *
@@ -90,7 +108,7 @@ static inline void gnrc_icmpv6_error_dst_unr_send(uint8_t code, gnrc_pktsnip_t *
     gnrc_pktsnip_t *pkt = gnrc_icmpv6_error_dst_unr_build(code, orig_pkt);
 
     if (pkt != NULL) {
-        gnrc_netapi_send(gnrc_ipv6_pid, pkt);
+        gnrc_icmpv6_error_pass_down(pkt);
     }
 #ifdef MODULE_GNRC_PKTBUF
     gnrc_pktbuf_release_error(orig_pkt, EHOSTUNREACH);
@@ -110,7 +128,7 @@ static inline void gnrc_icmpv6_error_pkt_too_big_send(uint32_t mtu, gnrc_pktsnip
     gnrc_pktsnip_t *pkt = gnrc_icmpv6_error_pkt_too_big_build(mtu, orig_pkt);
 
     if (pkt != NULL) {
-        gnrc_netapi_send(gnrc_ipv6_pid, pkt);
+        gnrc_icmpv6_error_pass_down(pkt);
     }
 #ifdef MODULE_GNRC_PKTBUF
     gnrc_pktbuf_release_error(orig_pkt, EMSGSIZE);
@@ -130,7 +148,7 @@ static inline void gnrc_icmpv6_error_time_exc_send(uint8_t code, gnrc_pktsnip_t
     gnrc_pktsnip_t *pkt = gnrc_icmpv6_error_time_exc_build(code, orig_pkt);
 
     if (pkt != NULL) {
-        gnrc_netapi_send(gnrc_ipv6_pid, pkt);
+        gnrc_icmpv6_error_pass_down(pkt);
     }
 #ifdef MODULE_GNRC_PKTBUF
     gnrc_pktbuf_release_error(orig_pkt, ETIMEDOUT);
@@ -152,7 +170,7 @@ static inline void gnrc_icmpv6_error_param_prob_send(uint8_t code, void *ptr,
     gnrc_pktsnip_t *pkt = gnrc_icmpv6_error_param_prob_build(code, ptr, orig_pkt);
 
     if (pkt != NULL) {
-        gnrc_netapi_send(gnrc_ipv6_pid, pkt);
+        gnrc_icmpv6_error_pass_down(pkt);
     }
 #ifdef MODULE_GNRC_PKTBUF
     gnrc_pktbuf_release_error(orig_pkt, EINVAL);
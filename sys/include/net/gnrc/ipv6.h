@@ -93,6 +93,10 @@ extern "C" {
  *
  * @details This variable is preferred for IPv6 internal communication *only*.
  *          Please use @ref net_gnrc_netreg for external communication.
+ *
+ * @note    With @ref net_gnrc_netapi_direct there is no IPv6 thread. The
+ *          variable then holds the PID of the network interface thread
+ *          handling the timer events of the @ref net_gnrc_ipv6_nib.
  */
 extern kernel_pid_t gnrc_ipv6_pid;
 
@@ -112,6 +116,10 @@ extern kernel_pid_t gnrc_ipv6_pid;
 /**
  * @brief   The forwarding information base (FIB) for the IPv6 stack.
  *
+ * Lookups scan the whole table, unless the `fib_trie` module is used to
+ * index the entries by a prefix trie of 2 * @ref GNRC_IPV6_FIB_TABLE_SIZE
+ * nodes.
+ *
  * @see @ref net_fib
  */
 extern fib_table_t gnrc_ipv6_fib_table;
@@ -127,6 +135,23 @@ extern fib_table_t gnrc_ipv6_fib_table;
  */
 kernel_pid_t gnrc_ipv6_init(void);
 
+#if defined(MODULE_GNRC_NETAPI_DIRECT) || defined(DOXYGEN)
+/**
+ * @brief   Handles a message addressed to @ref gnrc_ipv6_pid
+ *
+ * Called by the thread @ref gnrc_ipv6_pid refers to for every message it
+ * does not know itself.
+ *
+ * @note    Only available with @ref net_gnrc_netapi_direct.
+ *
+ * @param[in] msg   A message.
+ *
+ * @return  true, if @p msg was handled by IPv6.
+ * @return  false, if @p msg is not meant for IPv6.
+ */
+bool gnrc_ipv6_direct_handle_msg(msg_t *msg);
+#endif
+
 /**
  * @brief   Demultiplexes a packet according to @p nh.
  *
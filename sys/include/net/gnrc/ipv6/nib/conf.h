@@ -192,6 +192,19 @@ extern "C" {
 #ifndef GNRC_IPV6_NIB_CONF_MULTIHOP_DAD
 #define GNRC_IPV6_NIB_CONF_MULTIHOP_DAD (0)
 #endif
+
+/**
+ * @brief   Index off-link entries in a path-compressed prefix trie
+ *
+ * Longest prefix match for the forwarding table and the prefix list is then
+ * done by descending the trie instead of comparing the destination against
+ * every off-link entry. This makes lookup time depend on the depth of the
+ * trie rather than on @ref GNRC_IPV6_NIB_OFFL_NUMOF, at the cost of
+ * about `2 * GNRC_IPV6_NIB_OFFL_NUMOF` additional trie nodes in RAM.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_OFFL_TRIE
+#define GNRC_IPV6_NIB_CONF_OFFL_TRIE    (0)
+#endif
 /** @} */
 
 /**
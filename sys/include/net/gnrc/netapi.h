@@ -51,6 +51,56 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_batch   Batched dispatch extension
+ * @ingroup     net_gnrc_netapi
+ * @brief       Pass multiple packets between GNRC modules in one message
+ * @{
+ * @details The submodule `gnrc_netapi_batch` allows a module to hand a list
+ *          of packets to another module with a single message
+ *          (@ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH or
+ *          @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH), so the receiving thread
+ *          handles all of them in one wake-up.
+ *
+ * A thread collects the packets it dispatches between
+ * gnrc_netapi_batch_begin() and gnrc_netapi_batch_end(). Batch messages are
+ * only sent to threads that called gnrc_netapi_batch_enable(), all other
+ * subscribers still get one message per packet.
+ *
+ * To use, add the module `gnrc_netapi_batch` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_batch
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
+ *
+ * @defgroup    net_gnrc_netapi_direct   Single-thread direct call mode
+ * @ingroup     net_gnrc_netapi
+ * @brief       Run IPv6, 6LoWPAN and UDP without threads of their own
+ * @{
+ * @details With the submodule `gnrc_netapi_direct`, @ref net_gnrc_ipv6,
+ *          @ref net_gnrc_sixlowpan and @ref net_gnrc_udp do not start a
+ *          thread but register a [callback](@ref net_gnrc_netapi_callbacks)
+ *          instead. A packet is then passed between these layers by a plain
+ *          function call in the context of the thread dispatching it, i.e.
+ *          the network interface thread for received packets and the
+ *          application thread for sent packets. This saves the stacks and
+ *          message queues of these threads and the context switches in
+ *          between them.
+ *
+ * As the layers may now be entered by multiple threads, all of them are
+ * serialized by one recursive lock (see gnrc_netapi_direct_acquire()).
+ * Timer events of the @ref net_gnrc_ipv6_nib and 6LoWPAN fragmentation are
+ * handled by the thread of the first network interface.
+ *
+ * To use, add the module `gnrc_netapi_direct` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_direct
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
  * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
  * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
  */
@@ -92,6 +142,33 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   @ref core_msg type for passing a batch of @ref net_gnrc_pkt up the
+ *          network stack
+ *
+ * The message's content is a @ref GNRC_NETTYPE_UNDEF snip listing the
+ * packets, see @ref net_gnrc_netapi_batch.
+ */
+#define GNRC_NETAPI_MSG_TYPE_RCV_BATCH  (0x0207)
+
+/**
+ * @brief   @ref core_msg type for passing a batch of @ref net_gnrc_pkt down the
+ *          network stack
+ *
+ * The message's content is a @ref GNRC_NETTYPE_UNDEF snip listing the
+ * packets, see @ref net_gnrc_netapi_batch.
+ */
+#define GNRC_NETAPI_MSG_TYPE_SND_BATCH  (0x0208)
+
+/**
+ * @brief   Maximum number of packets collected into one batch
+ *
+ * @note    Only used with @ref net_gnrc_netapi_batch.
+ */
+#ifndef GNRC_NETAPI_BATCH_SIZE
+#define GNRC_NETAPI_BATCH_SIZE          (16U)
+#endif
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
@@ -103,6 +180,30 @@ typedef struct {
     uint16_t data_len;          /**< size of the data / the buffer */
 } gnrc_netapi_opt_t;
 
+#if defined(MODULE_GNRC_NETAPI_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Collector for packets dispatched by a thread
+ *
+ * At about 200 bytes (with the default @ref GNRC_NETAPI_BATCH_SIZE) a
+ * collector is too large for the stacks of the GNRC threads, so keep it in
+ * static memory.
+ *
+ * @note    Only available with @ref net_gnrc_netapi_batch.
+ */
+typedef struct {
+    unsigned numof;                     /**< number of collected packets */
+    gnrc_pktsnip_t *pkts[GNRC_NETAPI_BATCH_SIZE];   /**< the collected packets */
+    /**
+     * @brief   where to dispatch gnrc_netapi_batch_t::pkts to
+     */
+    struct {
+        uint32_t demux_ctx;             /**< demultiplexing context */
+        gnrc_nettype_t type;            /**< protocol type */
+        uint16_t cmd;                   /**< netapi command */
+    } targets[GNRC_NETAPI_BATCH_SIZE];
+} gnrc_netapi_batch_t;
+#endif
+
 /**
  * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_SND messages
  *
@@ -206,6 +307,108 @@ int gnrc_netapi_get(kernel_pid_t pid, netopt_t opt, uint16_t context,
 int gnrc_netapi_set(kernel_pid_t pid, netopt_t opt, uint16_t context,
                     void *data, size_t data_len);
 
+#if defined(MODULE_GNRC_NETAPI_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Sends @p cmd for a list of packets to all subscribers to
+ *          (@p type, @p demux_ctx).
+ *
+ * Subscribers that enabled batching with gnrc_netapi_batch_enable() get all
+ * packets in one @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH or
+ * @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH message, all others one message per
+ * packet.
+ *
+ * @note    Only available with @ref net_gnrc_netapi_batch.
+ *
+ * @param[in] type      protocol type of the targeted network module.
+ * @param[in] demux_ctx demultiplexing context for @p type.
+ * @param[in] cmd       command for all subscribers (@ref GNRC_NETAPI_MSG_TYPE_SND
+ *                      or @ref GNRC_NETAPI_MSG_TYPE_RCV)
+ * @param[in] pkts      the packets
+ * @param[in] numof     number of packets in @p pkts
+ *
+ * @return Number of subscribers to (@p type, @p demux_ctx).
+ */
+int gnrc_netapi_dispatch_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                               uint16_t cmd, gnrc_pktsnip_t **pkts,
+                               unsigned numof);
+
+/**
+ * @brief   Marks a thread as able to handle
+ *          @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH and
+ *          @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH messages
+ *
+ * @note    Only available with @ref net_gnrc_netapi_batch.
+ *
+ * @param[in] pid       PID of the thread
+ */
+void gnrc_netapi_batch_enable(kernel_pid_t pid);
+
+/**
+ * @brief   Starts collecting the packets the calling thread dispatches
+ *
+ * Until gnrc_netapi_batch_end() is called, gnrc_netapi_dispatch() does not
+ * send packets right away but adds them to @p batch. If @p batch is full,
+ * the collected packets are dispatched early.
+ *
+ * @note    Only available with @ref net_gnrc_netapi_batch.
+ *
+ * @pre     The calling thread is not collecting packets already.
+ *
+ * @param[out] batch    collector for the packets
+ */
+void gnrc_netapi_batch_begin(gnrc_netapi_batch_t *batch);
+
+/**
+ * @brief   Dispatches all packets collected since gnrc_netapi_batch_begin()
+ *          and stops collecting
+ *
+ * Packets for the same (type, demux context, command) are dispatched with
+ * gnrc_netapi_dispatch_batch().
+ *
+ * @note    Only available with @ref net_gnrc_netapi_batch.
+ *
+ * @param[in] batch     collector given to gnrc_netapi_batch_begin()
+ */
+void gnrc_netapi_batch_end(gnrc_netapi_batch_t *batch);
+
+/**
+ * @brief   Handles a @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH or
+ *          @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH message
+ *
+ * Calls @p handler for every packet of the batch while collecting the
+ * packets @p handler dispatches into @p collect, so they are passed on as a
+ * batch as well. The batch snip itself is released.
+ *
+ * @note    Only available with @ref net_gnrc_netapi_batch.
+ *
+ * @param[in] batch     content of the message
+ * @param[in] handler   handler for a single packet, takes ownership of it
+ * @param[out] collect  collector for the packets, owned by the calling thread
+ */
+void gnrc_netapi_batch_handle(gnrc_pktsnip_t *batch,
+                              void (*handler)(gnrc_pktsnip_t *pkt),
+                              gnrc_netapi_batch_t *collect);
+#endif
+
+#if defined(MODULE_GNRC_NETAPI_DIRECT) || defined(DOXYGEN)
+/**
+ * @brief   Acquires the lock of the layers run in direct call mode
+ *
+ * The lock is recursive, so a layer may dispatch to another layer while
+ * holding it.
+ *
+ * @note    Only available with @ref net_gnrc_netapi_direct.
+ */
+void gnrc_netapi_direct_acquire(void);
+
+/**
+ * @brief   Releases the lock acquired with gnrc_netapi_direct_acquire()
+ *
+ * @note    Only available with @ref net_gnrc_netapi_direct.
+ */
+void gnrc_netapi_direct_release(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
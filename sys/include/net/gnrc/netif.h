@@ -93,6 +93,14 @@ typedef struct {
 #endif
 #if defined(MODULE_GNRC_SIXLOWPAN) || DOXYGEN
     gnrc_netif_6lo_t sixlo;                 /**< 6Lo component */
+#endif
+#if defined(MODULE_GNRC_NETAPI_BATCH) || DOXYGEN
+    /**
+     * @brief   Collector for the packets received in one go
+     *
+     * @note    Only available with @ref net_gnrc_netapi_batch.
+     */
+    gnrc_netapi_batch_t batch;
 #endif
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
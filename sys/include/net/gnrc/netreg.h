@@ -79,6 +79,17 @@ typedef enum {
  */
 #define GNRC_NETREG_DEMUX_CTX_ALL   (0xffff0000)
 
+/**
+ * @brief   Number of hash buckets per @ref gnrc_nettype_t the registry
+ *          distributes its entries to by gnrc_netreg_entry_t::demux_ctx
+ *
+ * @note    Must be a power of 2. A value of 1 results in one list per
+ *          @ref gnrc_nettype_t.
+ */
+#ifndef GNRC_NETREG_BUCKETS
+#define GNRC_NETREG_BUCKETS         (4U)
+#endif
+
 /**
  * @name    Static entry initialization macros
  * @anchor  net_gnrc_netreg_init_static
@@ -93,7 +104,7 @@ typedef enum {
  *
  * @return  An initialized netreg entry
  */
-#ifdef MODULE_GNRC_NETAPI_MBOX
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
                                                       { pid } }
@@ -107,15 +118,15 @@ typedef enum {
  *
  * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
  *                      for the netreg entry
- * @param[in] mbox      Target @ref core_mbox "mailbox" for the registry entry
+ * @param[in] _mbox     Target @ref core_mbox "mailbox" for the registry entry
  *
  * @note    Only available with @ref net_gnrc_netapi_mbox.
  *
  * @return  An initialized netreg entry
  */
-#define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, mbox) { NULL, demux_ctx, \
-                                                       GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = mbox } }
+#define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, _mbox) { NULL, demux_ctx, \
+                                                        GNRC_NETREG_TYPE_MBOX, \
+                                                        { .mbox = _mbox } }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
@@ -124,15 +135,15 @@ typedef enum {
  *
  * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
  *                      for the netreg entry
- * @param[in] cbd       Target callback for the registry entry
+ * @param[in] _cbd      Target callback for the registry entry
  *
  * @note    Only available with @ref net_gnrc_netapi_callbacks.
  *
  * @return  An initialized netreg entry
  */
-#define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, cbd)   { NULL, demux_ctx, \
+#define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, _cbd)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = cbd } }
+                                                      { .cbd = _cbd } }
 /** @} */
 
 /**
@@ -346,6 +357,26 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
  */
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx);
 
+/**
+ * @brief   Searches for entries with given parameters in the registry and
+ *          returns the first found together with the number of entries
+ *
+ * Combines gnrc_netreg_lookup() and gnrc_netreg_num() into one lookup.
+ *
+ * @param[in] type      Type of the protocol.
+ * @param[in] demux_ctx The demultiplexing context for the registered thread.
+ *                      See gnrc_netreg_entry_t::demux_ctx.
+ * @param[out] num      Number of entries with the same
+ *                      gnrc_netreg_entry_t::type and
+ *                      gnrc_netreg_entry_t::demux_ctx as the given
+ *                      parameters. Must not be NULL.
+ *
+ * @return  The first entry fitting the given parameters on success
+ * @return  NULL if no entry can be found.
+ */
+gnrc_netreg_entry_t *gnrc_netreg_lookup_num(gnrc_nettype_t type,
+                                            uint32_t demux_ctx, int *num);
+
 /**
  * @brief   Returns the next entry after @p entry with the same
  *          gnrc_netreg_entry_t::type and gnrc_netreg_entry_t::demux_ctx as the
@@ -18,6 +18,16 @@
  *          this *will* lead to alignment problems and can potentially result
  *          in segmentation/hard faults and other unexpected behaviour.
  *
+ * The packet buffer is provided by one of the following modules:
+ *
+ * - `gnrc_pktbuf_static` (default): first-fit allocation from a static buffer
+ *   of @ref GNRC_PKTBUF_SIZE bytes.
+ * - `gnrc_pktbuf_tlsf`: allocation from a static buffer of
+ *   @ref GNRC_PKTBUF_SIZE bytes using segregated free lists, so allocation
+ *   and release take constant time regardless of buffer fragmentation. Needs
+ *   one additional bit of RAM per `sizeof(void *)` bytes of buffer.
+ * - `gnrc_pktbuf_malloc`: allocation from the heap via `malloc()`.
+ *
  * @{
  *
  * @file
@@ -31,6 +41,7 @@
 #define NET_GNRC_PKTBUF_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -58,6 +69,39 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @brief   Number of entries in gnrc_pktbuf_stats_t::snips
+ */
+#define GNRC_PKTBUF_STATS_NETTYPE_NUMOF (GNRC_NETTYPE_NUMOF - GNRC_NETTYPE_IOVEC)
+
+/**
+ * @brief   Statistics of the packet buffer
+ *
+ * @see     gnrc_pktbuf_get_stats()
+ */
+typedef struct {
+    size_t used;                /**< bytes currently allocated */
+    size_t used_peak;           /**< maximum of gnrc_pktbuf_stats_t::used
+                                 *   since initialization */
+    size_t largest_free;        /**< size of the largest free chunk in bytes
+                                 *   (always 0 for `gnrc_pktbuf_malloc`) */
+    uint32_t allocs;            /**< number of allocated chunks */
+    uint32_t frees;             /**< number of released chunks */
+    uint32_t alloc_fails;       /**< number of failed allocations */
+    /**
+     * @brief   number of failed allocations although enough bytes were
+     *          free in total, i.e. failures caused by fragmentation
+     */
+    uint32_t alloc_fails_frag;
+    /**
+     * @brief   number of snips created per type, indexed by
+     *          `type - GNRC_NETTYPE_IOVEC`
+     *
+     * @see     gnrc_pktbuf_stats_snips()
+     */
+    uint32_t snips[GNRC_PKTBUF_STATS_NETTYPE_NUMOF];
+} gnrc_pktbuf_stats_t;
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -275,6 +319,30 @@ gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *ol
  */
 gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type);
 
+/**
+ * @brief   Gets the statistics of the packet buffer
+ *
+ * @details All counters are reset by gnrc_pktbuf_init(). Sizes are given
+ *          including the alignment overhead of the backend.
+ *
+ * @param[out] stats    The current statistics.
+ */
+void gnrc_pktbuf_get_stats(gnrc_pktbuf_stats_t *stats);
+
+/**
+ * @brief   Gets the number of snips of a type from packet buffer statistics
+ *
+ * @param[in] stats The statistics.
+ * @param[in] type  The type of the snips, as it was on creation of the snip.
+ *
+ * @return  Number of snips of @p type created since initialization.
+ */
+static inline uint32_t gnrc_pktbuf_stats_snips(const gnrc_pktbuf_stats_t *stats,
+                                               gnrc_nettype_t type)
+{
+    return stats->snips[type - GNRC_NETTYPE_IOVEC];
+}
+
 #ifdef DEVELHELP
 /**
  * @brief   Prints some statistics about the packet buffer to stdout.
@@ -53,6 +53,21 @@ typedef struct {
                              *   payload datagram */
 } gnrc_sixlowpan_msg_frag_t;
 
+/**
+ * @brief   Statistics of the reassembly buffer
+ *
+ * @see     gnrc_sixlowpan_frag_rbuf_get_stats()
+ */
+typedef struct {
+    uint32_t datagrams;     /**< datagrams reassembled */
+    uint32_t timeouts;      /**< datagrams discarded since fragments were
+                             *   missing when they timed out */
+    uint32_t overlaps;      /**< datagrams discarded because of overlapping
+                             *   fragments */
+    uint32_t evictions;     /**< datagrams discarded to make room for new
+                             *   ones */
+} gnrc_sixlowpan_frag_rbuf_stats_t;
+
 /**
  * @brief   Sends a packet fragmented.
  *
@@ -61,6 +76,13 @@ typedef struct {
  */
 void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg);
 
+/**
+ * @brief   Gets a new datagram tag for fragments sent by this node
+ *
+ * @return  The next datagram tag.
+ */
+uint16_t gnrc_sixlowpan_frag_next_tag(void);
+
 /**
  * @brief   Handles a packet containing a fragment header.
  *
@@ -68,6 +90,13 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg);
  */
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Gets the statistics of the reassembly buffer
+ *
+ * @param[out] stats    Statistics since start-up.
+ */
+void gnrc_sixlowpan_frag_rbuf_get_stats(gnrc_sixlowpan_frag_rbuf_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_vrb 6LoWPAN fragment forwarding
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       Forwards 6LoWPAN fragments without reassembling the datagram
+ * @see <a href="https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-00">
+ *          draft-ietf-lwig-6lowpan-virtual-reassembly-00
+ *      </a>
+ *
+ * Without this module a router reassembles every fragmented datagram before
+ * it forwards it, so the whole datagram occupies the packet buffer and is only
+ * sent on once its last fragment arrived.
+ *
+ * With `gnrc_sixlowpan_frag_vrb` the first fragment of a datagram that is not
+ * addressed to this node is forwarded as soon as it arrives: its IPv6 header is
+ * decompressed, the hop limit is decremented, the next hop is looked up in the
+ * NIB and the header is compressed again for the next link. The virtual
+ * reassembly buffer (VRB) then maps the link-layer source and tag of the
+ * datagram to the next hop and the tag used towards it, so all subsequent
+ * fragments are only relabeled and sent on. Fragment offsets refer to the
+ * uncompressed datagram and stay valid.
+ *
+ * Datagrams are still reassembled if they are addressed to this node, if the
+ * VRB is full, if the recompressed first fragment does not fit the next link or
+ * if a subsequent fragment arrives before the first one.
+ *
+ * @{
+ *
+ * @file
+ * @brief   6LoWPAN fragment forwarding definitions
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+#define NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of datagrams that can be forwarded at the same time
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_SIZE
+#define GNRC_SIXLOWPAN_FRAG_VRB_SIZE        (16U)
+#endif
+
+/**
+ * @brief   Time in microseconds after which an entry of a datagram whose
+ *          fragments stopped arriving is removed
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT
+#define GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT     (3U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Statistics of the virtual reassembly buffer
+ *
+ * @see     gnrc_sixlowpan_frag_vrb_get_stats()
+ */
+typedef struct {
+    uint32_t datagrams;     /**< datagrams forwarded fragment by fragment */
+    uint32_t fragments;     /**< fragments forwarded */
+    uint32_t full;          /**< datagrams reassembled since the VRB was full */
+    uint32_t timeouts;      /**< datagrams whose entry timed out */
+} gnrc_sixlowpan_frag_vrb_stats_t;
+
+/**
+ * @brief   Forwards a fragment if it belongs to a datagram for another node
+ *
+ * @pre `pkt != NULL` and `pkt->next` is the interface header of the fragment
+ *
+ * @param[in] pkt       A received fragment. It is not released.
+ * @param[in] offset    Offset of the fragment in the uncompressed datagram.
+ *
+ * @return  true, if the fragment was forwarded or dropped as part of a
+ *          forwarded datagram.
+ * @return  false, if the fragment needs to be reassembled.
+ */
+bool gnrc_sixlowpan_frag_vrb_forward(gnrc_pktsnip_t *pkt, uint16_t offset);
+
+/**
+ * @brief   Gets the statistics of the virtual reassembly buffer
+ *
+ * @param[out] stats    Statistics since start-up.
+ */
+void gnrc_sixlowpan_frag_vrb_get_stats(gnrc_sixlowpan_frag_vrb_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_VRB_H */
+/** @} */
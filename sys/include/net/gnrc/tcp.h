@@ -52,6 +52,23 @@ int gnrc_tcp_init(void);
  */
 void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Set the receive buffer size of a connection.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p size must not be zero.
+ *
+ * @note Takes effect the next time the connection is established. The
+ *       buffer is taken from a pool shared by all connections, of
+ *       @ref GNRC_TCP_RCV_BUF_POOL_SIZE bytes. The window scale option is
+ *       not supported, so sizes above 65535 bytes are truncated.
+ *
+ * @param[in,out] tcb    TCB that should be configured.
+ * @param[in]     size   Receive buffer size in bytes.
+ */
+void gnrc_tcp_tcb_set_rcv_buf_size(gnrc_tcp_tcb_t *tcb, const size_t size);
+
  /**
   * @brief Opens a connection actively.
   *
@@ -106,12 +123,82 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
  *            -EINVAL if @p address_family is not the same the address_family used in TCB.
  *            -EISCONN if TCB is already in use.
- *            -ENOMEM if the receive buffer for the TCB could not be allocated.
- *            Hint: Increase "GNRC_TCP_RCV_BUFFERS".
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
                           const uint8_t *local_addr, const uint16_t local_port);
 
+/**
+ * @brief Listen for incomming connections with a queue of TCBs.
+ *
+ * Each TCB in @p tcbs accepts one connection, so @p tcbs_len connections can
+ * be established before they are accepted. Accepted connections are closed
+ * with gnrc_tcp_close() or gnrc_tcp_abort() as usual, afterwards their TCB
+ * listens again from the next call to gnrc_tcp_accept() on.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called on each TCB
+ *      in @p tcbs.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcbs must not be NULL.
+ * @pre if local_addr is not NULL, local_addr must be assigned to a network interface.
+ * @pre if local_port is not zero.
+ *
+ * @note Receive buffers are only taken from the pool when a connection
+ *       request arrives. Requests are dropped while the pool is exhausted.
+ *
+ * @param[out]    queue            Listen queue to initialize.
+ * @param[in,out] tcbs             TCBs waiting for connections.
+ * @param[in]     tcbs_len         Number of TCBs in @p tcbs.
+ * @param[in]     address_family   Address family of @p local_addr.
+ *                                 If local_addr == NULL, address_family is ignored.
+ * @param[in]     local_addr       If not NULL the connections are bound to @p local_addr.
+ *                                 If NULL a connection request to all local ip
+ *                                 addresses is valied.
+ * @param[in]     local_port       Port number to listen on.
+ *
+ * @returns   Zero on success.
+ *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
+ *            -EINVAL if @p address_family is not the same the address_family used in TCB.
+ *            -EISCONN if a TCB is already in use.
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, const size_t tcbs_len,
+                    const uint8_t address_family, const uint8_t *local_addr,
+                    const uint16_t local_port);
+
+/**
+ * @brief Accept an established connection from a listen queue.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note Function blocks if user_timeout_duration_us is not zero.
+ *
+ * @param[in,out] queue                      Listen queue to accept from.
+ * @param[out]    tcb                        TCB of the accepted connection.
+ * @param[in]     user_timeout_duration_us   Timeout for accept in microseconds.
+ *                                           If zero and no connection is established,
+ *                                           the function returns immediately.
+ *
+ * @returns   Zero on success.
+ *            -EINVAL if @p queue is not listening.
+ *            -EAGAIN if user_timeout_duration_us is zero and no connection is established.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Stop listening with a queue.
+ *
+ * Connections that were not accepted yet are aborted. Accepted connections
+ * stay open, their TCBs don't listen again after they were closed.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @param[in,out] queue   Listen queue to stop.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -120,6 +207,10 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ *       Transmitted data is kept for retransmission until it is
+ *       acknowledged, so this returns without waiting for an acknowledgment
+ *       as long as there is room in the send window and in the
+ *       retransmission queue (see @ref GNRC_TCP_RETRANSMIT_QUEUE_SIZE).
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
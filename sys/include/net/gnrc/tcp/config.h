@@ -68,7 +68,7 @@ extern "C" {
 #endif
 
 /**
- * @brief Number of preallocated receive buffers
+ * @brief Number of default sized receive buffers the receive buffer pool holds
  */
 #ifndef GNRC_TCP_RCV_BUFFERS
 #define GNRC_TCP_RCV_BUFFERS (1U)
@@ -76,11 +76,32 @@ extern "C" {
 
 /**
  * @brief Default receive buffer size
+ *
+ * Can be changed per connection with gnrc_tcp_tcb_set_rcv_buf_size(). The
+ * receive window advertised to the peer is the free space in this buffer.
  */
 #ifndef GNRC_TCP_RCV_BUF_SIZE
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Size of the receive buffer pool shared by all connections
+ *
+ * Receive buffers are taken from the pool on connection establishment. If it
+ * has not enough space left for a default sized buffer, a connection gets a
+ * smaller one.
+ */
+#ifndef GNRC_TCP_RCV_BUF_POOL_SIZE
+#define GNRC_TCP_RCV_BUF_POOL_SIZE (GNRC_TCP_RCV_BUFFERS * GNRC_TCP_RCV_BUF_SIZE)
+#endif
+
+/**
+ * @brief Allocation granularity of the receive buffer pool
+ */
+#ifndef GNRC_TCP_RCV_BUF_BLOCK_SIZE
+#define GNRC_TCP_RCV_BUF_BLOCK_SIZE (64U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
@@ -137,6 +158,31 @@ extern "C" {
 #define GNRC_TCP_PROBE_UPPER_BOUND (60U * US_PER_SEC)
 #endif
 
+/**
+ * @brief Number of unacknowledged segments kept for retransmission
+ *
+ * This is the maximum number of data segments in flight per connection, each
+ * of them holding up to @ref GNRC_TCP_MSS bytes in the packet buffer. One makes
+ * the connection stop-and-wait. A FIN may be queued in addition.
+ */
+#ifndef GNRC_TCP_RETRANSMIT_QUEUE_SIZE
+#define GNRC_TCP_RETRANSMIT_QUEUE_SIZE (2U)
+#endif
+
+/**
+ * @brief Initial congestion window in segments (see RFC 5681)
+ */
+#ifndef GNRC_TCP_CWND_INITIAL
+#define GNRC_TCP_CWND_INITIAL (2U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUP_ACK_THRESHOLD
+#define GNRC_TCP_DUP_ACK_THRESHOLD (3U)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,11 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @brief Listen queue, see gnrc_tcp_listen().
+ */
+struct _gnrc_tcp_tcb_queue;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -68,23 +73,44 @@ typedef struct _transmission_control_block {
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Send next when loss recovery started */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate ACKs */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< AckNo. completing the rtt measurement */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    gnrc_pktsnip_t *pkt_retransmit[GNRC_TCP_RETRANSMIT_QUEUE_SIZE + 1]; /**< Retransmit queue,
+                                                                             oldest first, one
+                                                                             entry kept for FIN */
+    uint8_t retransmit_num;  /**< Number of packets in retransmit queue */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    uint16_t rcv_buf_size;   /**< Requested receive buffer size */
+    struct _gnrc_tcp_tcb_queue *queue;        /**< Listen queue the TCB belongs to */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
+/**
+ * @brief Listen queue of GNRC TCP, holding TCBs waiting for connections.
+ */
+typedef struct _gnrc_tcp_tcb_queue {
+    mutex_t lock;                             /**< Mutex for accept synchronization */
+    gnrc_tcp_tcb_t *tcbs;                     /**< TCBs of the queue */
+    size_t tcbs_len;                          /**< Number of TCBs in the queue */
+    msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
+    mbox_t mbox;                              /**< Queue mbox, notified on connection changes */
+} gnrc_tcp_tcb_queue_t;
+
 #ifdef __cplusplus
 }
 #endif
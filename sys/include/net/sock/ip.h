@@ -272,6 +272,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 #include "net/sock.h"
 
@@ -450,6 +451,33 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
 ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
                      uint8_t proto, const sock_ip_ep_t *remote);
 
+/**
+ * @brief   Sends a message composed of multiple buffers to remote end point
+ *
+ * Behaves like @ref sock_ip_send(), but the payload is the concatenation of
+ * the buffers in @p vector. The buffers are copied exactly once into the
+ * network stack, so no contiguous staging buffer is needed.
+ *
+ * @pre `((sock != NULL || remote != NULL)) && ((count == 0) || (vector != NULL))`
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] vector    Buffers to send. A buffer may have a length of 0.
+ * @param[in] count     Number of entries in @p vector.
+ * @param[in] proto     Protocol to use in the packet sent, in case
+ *                      `sock == NULL`. If `sock != NULL` this parameter will be
+ *                      ignored.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  The same errors as @ref sock_ip_send().
+ */
+ssize_t sock_ip_sendv(sock_ip_t *sock, const struct iovec *vector,
+                      unsigned count, uint8_t proto,
+                      const sock_ip_ep_t *remote);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
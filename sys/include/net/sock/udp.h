@@ -272,6 +272,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 #include "net/sock.h"
 
@@ -401,6 +402,56 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Receives a UDP message from a remote end point without copying it
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * In contrast to @ref sock_udp_recv(), the payload is not copied into a
+ * buffer provided by the application. Instead @p data points to the payload
+ * within the network stack's buffer, which stays allocated until
+ * @p buf_ctx is handed to @ref sock_udp_recv_buf_free().
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer to the received data. Only valid until
+ *                      @p buf_ctx is released.
+ * @param[out] buf_ctx  Handle to the buffer of the received data. Must be
+ *                      released with @ref sock_udp_recv_buf_free() on
+ *                      success.
+ * @param[in] timeout   Timeout for receive in microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available).
+ * @param[out] remote   Remote end point of the received data.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @note    Function blocks if no packet is currently waiting.
+ * @note    Received data held by the application is not available to the
+ *          network stack, so @p buf_ctx should be released as soon as
+ *          possible.
+ *
+ * @return  The number of bytes received on success. @p buf_ctx is set to
+ *          a handle, even if the number is 0.
+ * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
+ * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -EINVAL, if @p remote is invalid or @p sock is not properly
+ *          initialized (or closed while sock_udp_recv_buf() blocks).
+ * @return  -ENOMEM, if no memory was available to receive @p data.
+ * @return  -EPROTO, if source address of received packet did not equal
+ *          the remote of @p sock.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
+/**
+ * @brief   Releases data received with @ref sock_udp_recv_buf()
+ *
+ * @param[in] buf_ctx   Handle returned by @ref sock_udp_recv_buf().
+ */
+void sock_udp_recv_buf_free(void *buf_ctx);
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -435,6 +486,29 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Sends a message composed of multiple buffers to remote end point
+ *
+ * Behaves like @ref sock_udp_send(), but the payload is the concatenation of
+ * the buffers in @p vector. The buffers are copied exactly once into the
+ * network stack, so no contiguous staging buffer is needed.
+ *
+ * @pre `((sock != NULL || remote != NULL)) && ((count == 0) || (vector != NULL))`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] vector    Buffers to send. A buffer may have a length of 0.
+ * @param[in] count     Number of entries in @p vector.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  The same errors as @ref sock_udp_send().
+ */
+ssize_t sock_udp_sendv(sock_udp_t *sock, const struct iovec *vector,
+                       unsigned count, const sock_udp_ep_t *remote);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_profile Scheduler profiling
+ * @ingroup     sys
+ * @brief       Records where threads spend their time and traces context
+ *              switches
+ *
+ * In addition to the run time accounted by `schedstatistics`, this module
+ * records per thread
+ *
+ * - the time spent blocked, split by what the thread was waiting for,
+ * - the maximum latency from being woken up (@ref STATUS_PENDING) to running,
+ *
+ * the time spent in interrupt service routines and a ring buffer of the
+ * last @ref SCHED_PROFILE_TRACE_SIZE context switches and interrupts. The
+ * trace can be printed in the Trace Event Format understood by
+ * `chrome://tracing` and Perfetto, e.g. to find which thread delays another
+ * one.
+ *
+ * Interrupts are accounted if the CPU calls sched_profile_isr_enter() and
+ * sched_profile_isr_exit() around them, which `native` does.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Scheduler profiling API
+ */
+
+#ifndef SCHED_PROFILE_H
+#define SCHED_PROFILE_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of context switches and interrupts kept in the trace
+ */
+#ifndef SCHED_PROFILE_TRACE_SIZE
+#define SCHED_PROFILE_TRACE_SIZE    (128U)
+#endif
+
+/**
+ * @brief   What a thread was blocked on
+ */
+typedef enum {
+    SCHED_PROFILE_BLOCKED_MSG = 0,      /**< sending, receiving or waiting
+                                             for a reply */
+    SCHED_PROFILE_BLOCKED_MUTEX,        /**< locking a mutex */
+    SCHED_PROFILE_BLOCKED_FLAGS,        /**< waiting for thread flags */
+    SCHED_PROFILE_BLOCKED_MBOX,         /**< waiting on a mailbox */
+    SCHED_PROFILE_BLOCKED_SLEEP,        /**< sleeping */
+    SCHED_PROFILE_BLOCKED_NUMOF,        /**< number of reasons */
+} sched_profile_blocked_t;
+
+/**
+ * @brief   Profile of a thread
+ */
+typedef struct {
+    uint64_t blocked[SCHED_PROFILE_BLOCKED_NUMOF];  /**< ticks spent blocked
+                                                         per reason */
+    uint32_t status_since;  /**< time of the last status change */
+    uint32_t woken_at;      /**< time the thread was woken up, if pending */
+    uint32_t latency_max;   /**< maximum ticks from wake-up to running */
+    uint8_t woken;          /**< the thread is pending after being woken up */
+} sched_profile_t;
+
+/**
+ * @brief   Time spent in interrupt service routines
+ */
+typedef struct {
+    uint64_t ticks;         /**< total ticks in ISRs */
+    uint32_t count;         /**< number of ISRs */
+    uint32_t max;           /**< longest ISR in ticks */
+} sched_profile_isr_t;
+
+/**
+ * @brief   Profile table, indexed by PID
+ */
+extern sched_profile_t sched_profile[KERNEL_PID_LAST + 1];
+
+/**
+ * @brief   Interrupt profile
+ */
+extern sched_profile_isr_t sched_profile_isr;
+
+/**
+ * @brief   Account a status change of a thread
+ *
+ * Called by the scheduler with interrupts disabled.
+ *
+ * @param[in] thread    thread changing its status
+ * @param[in] status    new status of @p thread
+ */
+void sched_profile_status(thread_t *thread, unsigned status);
+
+/**
+ * @brief   Account a context switch
+ *
+ * Called by the scheduler with interrupts disabled.
+ *
+ * @param[in] next      thread that is about to run
+ * @param[in] now       current time in xtimer ticks
+ */
+void sched_profile_switch(thread_t *next, uint32_t now);
+
+/**
+ * @brief   Mark the start of an interrupt service routine
+ */
+void sched_profile_isr_enter(void);
+
+/**
+ * @brief   Mark the end of an interrupt service routine
+ */
+void sched_profile_isr_exit(void);
+
+/**
+ * @brief   Reset all profiles and the trace
+ */
+void sched_profile_reset(void);
+
+/**
+ * @brief   Print the profile of all threads and interrupts
+ */
+void sched_profile_print(void);
+
+/**
+ * @brief   Print the trace in the Trace Event Format (JSON)
+ *
+ * Recording is paused while printing.
+ */
+void sched_profile_print_trace(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_PROFILE_H */
+/** @} */
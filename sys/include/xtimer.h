@@ -20,6 +20,22 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * With the module `xtimer_heap` the lists are replaced by pairing heaps,
+ * which makes insertion O(1) and removal O(log n) (amortized), at the cost
+ * of two more pointers per timer. Timers with the same target time may then
+ * fire in a different order than they were set in.
+ *
+ * xtimer wakes up the CPU at least once per period of the low-level timer to
+ * extend it in software, which is every 65 ms for a 16 bit timer at 1 MHz.
+ * With the module `xtimer_tickless`, the idle thread skips these overflow
+ * interrupts when no timer is due before them: it sleeps until the next timer
+ * on the RTT and advances xtimer's time on wake-up. Should the low-level timer
+ * stop in the mode entered by pm_set_lowest(), xtimer's time base is moved to
+ * the time told by the RTT instead, which loses up to two RTT ticks per sleep.
+ * xtimer owns the RTT alarm with this module, and it requires `periph_rtt`,
+ * so it is not available on native. The module `xtimer_wakeups` counts
+ * wake-ups by xtimer to compare both modes.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -74,6 +90,12 @@ typedef struct xtimer {
     xtimer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                   /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_HEAP) || defined(DOXYGEN)
+    struct xtimer *child;        /**< first child in timer heaps
+                                      (only with module `xtimer_heap`) */
+    struct xtimer *prev;         /**< parent or previous sibling in timer heaps
+                                      (only with module `xtimer_heap`) */
+#endif
 } xtimer_t;
 
 /**
@@ -450,6 +472,56 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
  */
 void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout);
 
+#if defined(MODULE_XTIMER_TICKLESS) || defined(DOXYGEN)
+/**
+ * @brief   Put the CPU to sleep until the next timer is due
+ *
+ * Called by the idle thread in place of pm_set_lowest() (only with module
+ * `xtimer_tickless`, which provides kernel_idle()). If the next timer is due
+ * after the next overflow of the low-level timer, the CPU sleeps on the RTT
+ * instead and the overflows in between are accounted for on wake-up. Timers
+ * that are due on wake-up are fired from the timer interrupt.
+ *
+ * @pre pm_set_lowest() returns on a pending interrupt also when called with
+ *      interrupts disabled, as on Cortex-M.
+ */
+void xtimer_tickless_idle(void);
+#endif
+
+#if defined(MODULE_XTIMER_WAKEUPS) || defined(DOXYGEN)
+/**
+ * @brief   Wake-up counters (only with module `xtimer_wakeups`)
+ */
+typedef struct {
+    uint32_t overflows;     /**< interrupts only handling a low-level timer
+                                 overflow */
+    uint32_t timers;        /**< interrupts handling due timers */
+    uint32_t tickless;      /**< wake-ups from tickless sleeps */
+    uint64_t since;         /**< ticks at the last reset */
+} xtimer_wakeups_t;
+
+/**
+ * @brief   Get the wake-up counters since the last reset
+ *
+ * @param[out] wakeups  the wake-up counters
+ */
+void xtimer_wakeups_get(xtimer_wakeups_t *wakeups);
+
+/**
+ * @brief   Reset the wake-up counters
+ */
+void xtimer_wakeups_reset(void);
+
+/**
+ * @brief   Compute the wake-up rate from counters
+ *
+ * @param[in] wakeups   wake-up counters from xtimer_wakeups_get()
+ *
+ * @return  wake-ups per hour since the counters were reset
+ */
+uint32_t xtimer_wakeups_per_hour(const xtimer_wakeups_t *wakeups);
+#endif
+
 /**
  * @brief xtimer backoff value
  *
@@ -497,6 +569,17 @@ void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout);
 #define XTIMER_ISR_BACKOFF 20
 #endif
 
+#ifndef XTIMER_TICKLESS_MARGIN
+/**
+ * @brief   Time to wake up before a timer after a tickless sleep, in
+ *          microseconds
+ *
+ * Covers the resolution of the RTT and the time to restart xtimer after
+ * wake-up.
+ */
+#define XTIMER_TICKLESS_MARGIN (1000U)
+#endif
+
 #ifndef XTIMER_PERIODIC_SPIN
 /**
  * @brief   xtimer_periodic_wakeup spin cutoff
@@ -33,19 +33,15 @@ extern "C" {
 extern volatile uint32_t _xtimer_high_cnt;
 #endif
 
+#ifdef MODULE_XTIMER_TICKLESS
+extern volatile uint32_t _xtimer_lltimer_offset;
+#endif
+
 /**
  * @brief IPC message type for xtimer msg callback
  */
 #define MSG_XTIMER 12345
 
-/**
- * @brief returns the (masked) low-level timer counter value.
- */
-static inline uint32_t _xtimer_lltimer_now(void)
-{
-    return timer_read(XTIMER_DEV);
-}
-
 /**
  * @brief drop bits of a value that don't fit into the low-level timer.
  */
@@ -56,6 +52,22 @@ static inline uint32_t _xtimer_lltimer_mask(uint32_t val)
     return val & ~XTIMER_MASK;
 }
 
+/**
+ * @brief returns the (masked) low-level timer counter value.
+ *
+ * With `xtimer_tickless`, this is shifted by the time the low-level timer
+ * did not count during sleep.
+ */
+static inline uint32_t _xtimer_lltimer_now(void)
+{
+#ifdef MODULE_XTIMER_TICKLESS
+    return _xtimer_lltimer_mask(timer_read(XTIMER_DEV) +
+                                _xtimer_lltimer_offset);
+#else
+    return timer_read(XTIMER_DEV);
+#endif
+}
+
 /**
  * @{
  * @brief xtimer internal stuff
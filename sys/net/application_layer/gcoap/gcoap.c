@@ -40,6 +40,13 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                            const sock_udp_ep_t *remote);
 static void _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
                                             gcoap_listener_t **listener_ptr);
+static size_t _match_subtree(const char *url, const char *path);
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+static void _index_add(coap_resource_t *resource, gcoap_listener_t *listener);
+static bool _index_find(const char *url, unsigned method_flag,
+                        coap_resource_t **resource_ptr,
+                        gcoap_listener_t **listener_ptr);
+#endif
 static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
 static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu);
@@ -61,6 +68,26 @@ static gcoap_state_t _coap_state = {
     .listeners   = &_default_listener,
 };
 
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+/* Entry of the resource index */
+typedef struct {
+    coap_resource_t *resource;
+    gcoap_listener_t *listener;
+} _index_entry_t;
+
+/*
+ * Resources with an exact path come first, sorted by path. Subtree resources
+ * follow, longest path first. Entries with equal keys are kept in the order of
+ * registration, which is the order of the linear search.
+ */
+static _index_entry_t _index[GCOAP_RESOURCE_INDEX_SIZE] = {
+    { (coap_resource_t *)&_default_resources[0], &_default_listener },
+};
+static unsigned _index_exact = 1;   /* number of exact path entries */
+static unsigned _index_len = 1;     /* number of entries */
+static bool _index_full = false;    /* some resources were not indexed */
+#endif
+
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _msg_stack[GCOAP_STACK_SIZE];
 static sock_udp_t _sock;
@@ -264,6 +291,8 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 /*
  * Searches listener registrations for the resource matching the path in a PDU.
  *
+ * An exact match is preferred, then the subtree resource with the longest path.
+ *
  * param[out] resource_ptr -- found resource
  * param[out] listener_ptr -- listener for found resource
  */
@@ -271,6 +300,21 @@ static void _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
                                             gcoap_listener_t **listener_ptr)
 {
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
+    const char *url = (char *)&pdu->url[0];
+    size_t subtree_len = 0;
+
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+    mutex_lock(&_coap_state.lock);
+    bool found = _index_find(url, method_flag, resource_ptr, listener_ptr);
+    mutex_unlock(&_coap_state.lock);
+    if (found) {
+        return;
+    }
+#endif
+
+    /* resource not found yet */
+    *resource_ptr = NULL;
+    *listener_ptr = NULL;
 
     /* Find path for CoAP msg among listener resources and execute callback. */
     gcoap_listener_t *listener = _coap_state.listeners;
@@ -284,15 +328,27 @@ static void _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
                 continue;
             }
 
-            int res = strcmp((char *)&pdu->url[0], resource->path);
-            if (res > 0) {
+            int res = strcmp(url, resource->path);
+            if (res < 0) {
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+                /* listeners need not be in order with the index, so a
+                 * resource that did not fit it may still follow */
                 continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
+#else
+                /* resources expected in alphabetical order; a subtree path
+                 * sorts before the paths below it */
                 break;
+#endif
             }
-            else {
+            else if (resource->methods & GCOAP_MATCH_SUBTREE) {
+                size_t len = _match_subtree(url, resource->path);
+                if (len > subtree_len) {
+                    subtree_len   = len;
+                    *resource_ptr = resource;
+                    *listener_ptr = listener;
+                }
+            }
+            else if (res == 0) {
                 *resource_ptr = resource;
                 *listener_ptr = listener;
                 return;
@@ -300,10 +356,125 @@ static void _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
         }
         listener = listener->next;
     }
-    /* resource not found */
+}
+
+/*
+ * Checks if a request path is a subtree resource path or lies below it.
+ *
+ * Returns the length of the resource path on a match, otherwise 0.
+ */
+static size_t _match_subtree(const char *url, const char *path)
+{
+    size_t len = strlen(path);
+
+    if (strncmp(url, path, len) != 0) {
+        return 0;
+    }
+    if ((url[len] == '\0') || (url[len] == '/')
+            || ((len > 0) && (path[len - 1] == '/'))) {
+        return len;
+    }
+    return 0;
+}
+
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+/*
+ * Binary search among the exact path entries of the index.
+ *
+ * Returns the first entry whose path is greater than or equal to path, or with
+ * after set, the first entry whose path is greater.
+ */
+static unsigned _index_search(const char *path, bool after)
+{
+    unsigned lo = 0;
+    unsigned hi = _index_exact;
+
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        int res = strcmp(_index[mid].resource->path, path);
+
+        if ((res < 0) || (after && (res == 0))) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/*
+ * Adds a resource to the index, behind the entries with an equal key.
+ *
+ * Must be called with _coap_state.lock held.
+ */
+static void _index_add(coap_resource_t *resource, gcoap_listener_t *listener)
+{
+    unsigned pos;
+
+    if (_index_len == GCOAP_RESOURCE_INDEX_SIZE) {
+        DEBUG("gcoap: resource index full, %s not indexed\n", resource->path);
+        _index_full = true;
+        return;
+    }
+    if (resource->methods & GCOAP_MATCH_SUBTREE) {
+        size_t len = strlen(resource->path);
+        for (pos = _index_exact; pos < _index_len; pos++) {
+            if (strlen(_index[pos].resource->path) < len) {
+                break;
+            }
+        }
+    }
+    else {
+        pos = _index_search(resource->path, true);
+        _index_exact++;
+    }
+    memmove(&_index[pos + 1], &_index[pos],
+            (_index_len - pos) * sizeof(_index[0]));
+    _index[pos].resource = resource;
+    _index[pos].listener = listener;
+    _index_len++;
+}
+
+/*
+ * Looks up the resource for a request path in the index.
+ *
+ * Must be called with _coap_state.lock held.
+ *
+ * Returns true if the result is final, or false if the request must be
+ * searched linearly, because the path may belong to a resource that did not
+ * fit the index.
+ */
+static bool _index_find(const char *url, unsigned method_flag,
+                        coap_resource_t **resource_ptr,
+                        gcoap_listener_t **listener_ptr)
+{
+    for (unsigned i = _index_search(url, false); i < _index_exact; i++) {
+        if (strcmp(_index[i].resource->path, url) != 0) {
+            break;
+        }
+        if (_index[i].resource->methods & method_flag) {
+            *resource_ptr = _index[i].resource;
+            *listener_ptr = _index[i].listener;
+            return true;
+        }
+    }
+    if (_index_full) {
+        return false;
+    }
+    for (unsigned i = _index_exact; i < _index_len; i++) {
+        if ((_index[i].resource->methods & method_flag)
+                && _match_subtree(url, _index[i].resource->path)) {
+            *resource_ptr = _index[i].resource;
+            *listener_ptr = _index[i].listener;
+            return true;
+        }
+    }
     *resource_ptr = NULL;
     *listener_ptr = NULL;
+    return true;
 }
+#endif
 
 /*
  * Finishes handling a PDU -- write options and reposition payload.
@@ -599,6 +770,10 @@ kernel_pid_t gcoap_init(void)
 
 void gcoap_register_listener(gcoap_listener_t *listener)
 {
+    /* link and index the listener in one go, so a request looked up in
+     * between does not miss it */
+    mutex_lock(&_coap_state.lock);
+
     /* Add the listener to the end of the linked list. */
     gcoap_listener_t *_last = _coap_state.listeners;
     while (_last->next) {
@@ -607,6 +782,13 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 
     listener->next = NULL;
     _last->next = listener;
+
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+    for (size_t i = 0; i < listener->resources_len; i++) {
+        _index_add(&listener->resources[i], listener);
+    }
+#endif
+    mutex_unlock(&_coap_state.lock);
 }
 
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
@@ -18,8 +18,13 @@
  * @}
  */
 
+#include <string.h>
+
+#include "bitfield.h"
+#include "irq.h"
 #include "mbox.h"
 #include "msg.h"
+#include "rmutex.h"
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
@@ -27,6 +32,25 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+/**
+ * @brief   Packet collector of each thread, NULL if it is not collecting
+ */
+static gnrc_netapi_batch_t *_batches[KERNEL_PID_LAST + 1];
+
+/**
+ * @brief   Threads able to handle batch messages
+ */
+static BITFIELD(_batch_pids, KERNEL_PID_LAST + 1);
+#endif
+
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+/**
+ * @brief   Serializes the layers called directly by their callbacks
+ */
+static rmutex_t _direct_lock = RMUTEX_INIT;
+#endif
+
 /**
  * @brief   Unified function for getting and setting netapi options
  *
@@ -91,53 +115,251 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
-int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
-                         uint16_t cmd, gnrc_pktsnip_t *pkt)
+static void _dispatch_entry(gnrc_netreg_entry_t *sendto, uint16_t cmd,
+                            gnrc_pktsnip_t *pkt)
 {
-    int numof = gnrc_netreg_num(type, demux_ctx);
-
-    if (numof != 0) {
-        gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
-
-        gnrc_pktbuf_hold(pkt, numof - 1);
-
-        while (sendto) {
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-            int release = 0;
-            switch (sendto->type) {
-                case GNRC_NETREG_TYPE_DEFAULT:
-                    if (_snd_rcv(sendto->target.pid, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        release = 1;
-                    }
-                    break;
+    int release = 0;
+    switch (sendto->type) {
+        case GNRC_NETREG_TYPE_DEFAULT:
+            if (_snd_rcv(sendto->target.pid, cmd, pkt) < 1) {
+                /* unable to dispatch packet */
+                release = 1;
+            }
+            break;
 #ifdef MODULE_GNRC_NETAPI_MBOX
-                case GNRC_NETREG_TYPE_MBOX:
-                    if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        release = 1;
-                    }
-                    break;
+        case GNRC_NETREG_TYPE_MBOX:
+            if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
+                /* unable to dispatch packet */
+                release = 1;
+            }
+            break;
 #endif
 #ifdef MODULE_GNRC_NETAPI_CALLBACKS
-                case GNRC_NETREG_TYPE_CB:
-                    sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
-                    break;
+        case GNRC_NETREG_TYPE_CB:
+            sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
+            break;
+#endif
+        default:
+            /* unknown dispatch type */
+            release = 1;
+            break;
+    }
+    if (release) {
+        gnrc_pktbuf_release(pkt);
+    }
+#else
+    if (_snd_rcv(sendto->target.pid, cmd, pkt) < 1) {
+        /* unable to dispatch packet */
+        gnrc_pktbuf_release(pkt);
+    }
+#endif
+}
+
+#ifdef MODULE_GNRC_NETAPI_BATCH
+/**
+ * @brief   Sends all packets in one batch message to a subscriber
+ *
+ * @return  1 if the packets were sent (or dropped) as batch
+ * @return  0 if the packets need to be sent one by one
+ */
+static int _dispatch_entry_batch(gnrc_netreg_entry_t *sendto, uint16_t cmd,
+                                 gnrc_pktsnip_t **pkts, unsigned numof)
+{
+    gnrc_pktsnip_t *batch;
+
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    if (sendto->type != GNRC_NETREG_TYPE_DEFAULT) {
+        return 0;
+    }
 #endif
-                default:
-                    /* unknown dispatch type */
-                    release = 1;
-                    break;
+    if ((numof < 2) || !pid_is_valid(sendto->target.pid) ||
+        !bf_isset(_batch_pids, sendto->target.pid)) {
+        return 0;
+    }
+    batch = gnrc_pktbuf_add(NULL, pkts, numof * sizeof(gnrc_pktsnip_t *),
+                            GNRC_NETTYPE_UNDEF);
+    if (batch == NULL) {
+        DEBUG("gnrc_netapi: no space for batch of %u packets\n", numof);
+        return 0;
+    }
+    if (_snd_rcv(sendto->target.pid, (cmd == GNRC_NETAPI_MSG_TYPE_SND) ?
+                                     GNRC_NETAPI_MSG_TYPE_SND_BATCH :
+                                     GNRC_NETAPI_MSG_TYPE_RCV_BATCH,
+                 batch) < 1) {
+        /* unable to dispatch batch */
+        for (unsigned i = 0; i < numof; i++) {
+            gnrc_pktbuf_release(pkts[i]);
+        }
+        gnrc_pktbuf_release(batch);
+    }
+    return 1;
+}
+
+int gnrc_netapi_dispatch_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                               uint16_t cmd, gnrc_pktsnip_t **pkts,
+                               unsigned numof)
+{
+    int numof_sub;
+    gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup_num(type, demux_ctx,
+                                                         &numof_sub);
+
+    if (numof_sub != 0) {
+        for (unsigned i = 0; i < numof; i++) {
+            gnrc_pktbuf_hold(pkts[i], numof_sub - 1);
+        }
+
+        while (sendto) {
+            if (!_dispatch_entry_batch(sendto, cmd, pkts, numof)) {
+                for (unsigned i = 0; i < numof; i++) {
+                    _dispatch_entry(sendto, cmd, pkts[i]);
+                }
             }
-            if (release) {
-                gnrc_pktbuf_release(pkt);
+            sendto = gnrc_netreg_getnext(sendto);
+        }
+    }
+
+    return numof_sub;
+}
+
+/**
+ * @brief   Moves a collected packet to an earlier position, shifting the
+ *          packets in between back
+ */
+static void _batch_move(gnrc_netapi_batch_t *batch, unsigned from, unsigned to)
+{
+    gnrc_pktsnip_t *pkt = batch->pkts[from];
+    uint32_t demux_ctx = batch->targets[from].demux_ctx;
+    gnrc_nettype_t type = batch->targets[from].type;
+    uint16_t cmd = batch->targets[from].cmd;
+
+    memmove(&batch->pkts[to + 1], &batch->pkts[to],
+            (from - to) * sizeof(batch->pkts[0]));
+    memmove(&batch->targets[to + 1], &batch->targets[to],
+            (from - to) * sizeof(batch->targets[0]));
+    batch->pkts[to] = pkt;
+    batch->targets[to].demux_ctx = demux_ctx;
+    batch->targets[to].type = type;
+    batch->targets[to].cmd = cmd;
+}
+
+/**
+ * @brief   Dispatches all packets of a collector, grouped by their target
+ */
+static void _batch_flush(gnrc_netapi_batch_t *batch)
+{
+    unsigned i = 0;
+
+    while (i < batch->numof) {
+        unsigned numof = 1;
+
+        /* group the packets for the same target in place, in the order they
+         * were collected */
+        for (unsigned j = i + 1; j < batch->numof; j++) {
+            if ((batch->targets[j].type == batch->targets[i].type) &&
+                (batch->targets[j].demux_ctx == batch->targets[i].demux_ctx) &&
+                (batch->targets[j].cmd == batch->targets[i].cmd)) {
+                if (j != (i + numof)) {
+                    _batch_move(batch, j, i + numof);
+                }
+                numof++;
             }
-#else
-            if (_snd_rcv(sendto->target.pid, cmd, pkt) < 1) {
-                /* unable to dispatch packet */
-                gnrc_pktbuf_release(pkt);
+        }
+        if (gnrc_netapi_dispatch_batch(batch->targets[i].type,
+                                       batch->targets[i].demux_ctx,
+                                       batch->targets[i].cmd, &batch->pkts[i],
+                                       numof) == 0) {
+            /* subscribers left since the packets were collected */
+            for (unsigned j = i; j < (i + numof); j++) {
+                gnrc_pktbuf_release(batch->pkts[j]);
             }
+        }
+        i += numof;
+    }
+    batch->numof = 0;
+}
+
+void gnrc_netapi_batch_enable(kernel_pid_t pid)
+{
+    unsigned state = irq_disable();
+
+    assert(pid_is_valid(pid));
+    bf_set(_batch_pids, pid);
+    irq_restore(state);
+}
+
+void gnrc_netapi_batch_begin(gnrc_netapi_batch_t *batch)
+{
+    assert(_batches[sched_active_pid] == NULL);
+    batch->numof = 0;
+    _batches[sched_active_pid] = batch;
+}
+
+void gnrc_netapi_batch_end(gnrc_netapi_batch_t *batch)
+{
+    assert(_batches[sched_active_pid] == batch);
+    /* stop collecting first, dispatching must not collect again */
+    _batches[sched_active_pid] = NULL;
+    _batch_flush(batch);
+}
+
+void gnrc_netapi_batch_handle(gnrc_pktsnip_t *batch,
+                              void (*handler)(gnrc_pktsnip_t *pkt),
+                              gnrc_netapi_batch_t *collect)
+{
+    gnrc_pktsnip_t **pkts = batch->data;
+
+    gnrc_netapi_batch_begin(collect);
+    for (unsigned i = 0; i < (batch->size / sizeof(gnrc_pktsnip_t *)); i++) {
+        handler(pkts[i]);
+    }
+    gnrc_netapi_batch_end(collect);
+    gnrc_pktbuf_release(batch);
+}
+#endif
+
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+void gnrc_netapi_direct_acquire(void)
+{
+    rmutex_lock(&_direct_lock);
+}
+
+void gnrc_netapi_direct_release(void)
+{
+    rmutex_unlock(&_direct_lock);
+}
 #endif
+
+int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
+                         uint16_t cmd, gnrc_pktsnip_t *pkt)
+{
+    int numof;
+    gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup_num(type, demux_ctx,
+                                                         &numof);
+
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    gnrc_netapi_batch_t *batch = (irq_is_in()) ? NULL : _batches[sched_active_pid];
+
+    if ((numof != 0) && (batch != NULL)) {
+        if (batch->numof >= GNRC_NETAPI_BATCH_SIZE) {
+            _batches[sched_active_pid] = NULL;
+            _batch_flush(batch);
+            _batches[sched_active_pid] = batch;
+        }
+        batch->pkts[batch->numof] = pkt;
+        batch->targets[batch->numof].demux_ctx = demux_ctx;
+        batch->targets[batch->numof].type = type;
+        batch->targets[batch->numof].cmd = cmd;
+        batch->numof++;
+        return numof;
+    }
+#endif
+
+    if (numof != 0) {
+        gnrc_pktbuf_hold(pkt, numof - 1);
+
+        while (sendto) {
+            _dispatch_entry(sendto, cmd, pkt);
             sendto = gnrc_netreg_getnext(sendto);
         }
     }
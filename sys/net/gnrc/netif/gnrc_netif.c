@@ -25,6 +25,14 @@
 #ifdef MODULE_NETSTATS_IPV6
 #include "net/netstats.h"
 #endif
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+#ifdef MODULE_GNRC_IPV6
+#include "net/gnrc/ipv6.h"
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+#include "net/gnrc/sixlowpan/frag.h"
+#endif
+#endif
 #include "log.h"
 #include "sched.h"
 
@@ -41,6 +49,9 @@ static gnrc_netif_t _netifs[GNRC_NETIF_NUMOF];
 static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static bool _handle_direct_msg(msg_t *msg);
+#endif
 
 gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, char priority,
                                 const char *name, netdev_t *netdev,
@@ -1208,6 +1219,17 @@ static void *_gnrc_netif_thread(void *args)
 
     DEBUG("gnrc_netif: starting thread %i\n", sched_active_pid);
     netif = args;
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    /* the layers above may be called while initializing the interface, so
+     * lock them first to keep the lock order */
+    gnrc_netapi_direct_acquire();
+#ifdef MODULE_GNRC_IPV6
+    if (gnrc_ipv6_pid == KERNEL_PID_UNDEF) {
+        /* handle timer events of IPv6 in this thread */
+        gnrc_ipv6_pid = sched_active_pid;
+    }
+#endif
+#endif
     gnrc_netif_acquire(netif);
     dev = netif->dev;
     netif->pid = sched_active_pid;
@@ -1228,10 +1250,27 @@ static void *_gnrc_netif_thread(void *args)
     }
     /* now let rest of GNRC use the interface */
     gnrc_netif_release(netif);
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    gnrc_netapi_direct_release();
+#endif
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    gnrc_netapi_batch_begin(&netif->batch);
+#endif
 
     while (1) {
+#ifdef MODULE_GNRC_NETAPI_BATCH
+        /* pass packets received while draining the message queue up in one
+         * batch */
+        if (msg_try_receive(&msg) != 1) {
+            gnrc_netapi_batch_end(&netif->batch);
+            DEBUG("gnrc_netif: waiting for incoming messages\n");
+            msg_receive(&msg);
+            gnrc_netapi_batch_begin(&netif->batch);
+        }
+#else
         DEBUG("gnrc_netif: waiting for incoming messages\n");
         msg_receive(&msg);
+#endif
         /* dispatch netdev, MAC and gnrc_netapi messages */
         switch (msg.type) {
             case NETDEV_MSG_TYPE_EVENT:
@@ -1277,6 +1316,11 @@ static void *_gnrc_netif_thread(void *args)
                 msg_reply(&msg, &reply);
                 break;
             default:
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+                if (_handle_direct_msg(&msg)) {
+                    break;
+                }
+#endif
                 if (netif->ops->msg_handler) {
                     DEBUG("gnrc_netif: delegate message of type 0x%04x to "
                           "netif->ops->msg_handler()\n", msg.type);
@@ -1293,6 +1337,34 @@ static void *_gnrc_netif_thread(void *args)
     return NULL;
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+/**
+ * @brief   Handles messages of the layers that run without a thread of their
+ *          own
+ *
+ * @return  true, if @p msg was handled
+ */
+static bool _handle_direct_msg(msg_t *msg)
+{
+#ifdef MODULE_GNRC_IPV6
+    if ((gnrc_ipv6_pid == sched_active_pid) && gnrc_ipv6_direct_handle_msg(msg)) {
+        return true;
+    }
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+    if (msg->type == GNRC_SIXLOWPAN_MSG_FRAG_SND) {
+        DEBUG("gnrc_netif: send fragmented event received\n");
+        gnrc_netapi_direct_acquire();
+        gnrc_sixlowpan_frag_send(msg->content.ptr);
+        gnrc_netapi_direct_release();
+        return true;
+    }
+#endif
+    (void)msg;
+    return false;
+}
+#endif
+
 static void _pass_on_packet(gnrc_pktsnip_t *pkt)
 {
     /* throw away packet if no one is interested */
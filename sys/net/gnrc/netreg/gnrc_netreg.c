@@ -27,13 +27,30 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#if (GNRC_NETREG_BUCKETS & (GNRC_NETREG_BUCKETS - 1)) != 0
+#error "GNRC_NETREG_BUCKETS must be a power of 2"
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t and hash of the demux
+ * context. Entries with the same demux context are kept next to each other
+ * within their bucket. */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_bucket(gnrc_nettype_t type,
+                                            uint32_t demux_ctx)
+{
+    /* demux contexts are mostly port or protocol numbers, so fold the
+     * higher bytes into the lower ones */
+    uint32_t hash = demux_ctx ^ (demux_ctx >> 16);
+
+    hash ^= hash >> 8;
+    return &netreg[type][hash & (GNRC_NETREG_BUCKETS - 1)];
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -53,7 +70,18 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    gnrc_netreg_entry_t **ptr = _bucket(type, entry->demux_ctx);
+
+    /* insert in front of the entries with the same demux context (or the
+     * bucket if there are none) */
+    while ((*ptr != NULL) && ((*ptr)->demux_ctx != entry->demux_ctx)) {
+        ptr = &(*ptr)->next;
+    }
+    if (*ptr == NULL) {
+        ptr = _bucket(type, entry->demux_ctx);
+    }
+    entry->next = *ptr;
+    *ptr = entry;
 
     return 0;
 }
@@ -64,7 +92,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_bucket(type, entry->demux_ctx), entry);
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
@@ -75,46 +103,41 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
         return NULL;
     }
 
-    LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
+    LL_SEARCH_SCALAR(*_bucket(type, demux_ctx), res, demux_ctx, demux_ctx);
 
     return res;
 }
 
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
 {
-    int num = 0;
-    gnrc_netreg_entry_t *entry;
-
-    if (_INVALID_TYPE(type)) {
-        return 0;
-    }
+    int num;
 
-    entry = netreg[type];
+    gnrc_netreg_lookup_num(type, demux_ctx, &num);
+    return num;
+}
 
-    while (entry != NULL) {
-        if (entry->demux_ctx == demux_ctx) {
-            num++;
-        }
+gnrc_netreg_entry_t *gnrc_netreg_lookup_num(gnrc_nettype_t type,
+                                            uint32_t demux_ctx, int *num)
+{
+    gnrc_netreg_entry_t *res = gnrc_netreg_lookup(type, demux_ctx);
 
-        entry = entry->next;
+    *num = 0;
+    for (gnrc_netreg_entry_t *entry = res; entry != NULL;
+         entry = gnrc_netreg_getnext(entry)) {
+        (*num)++;
     }
 
-    return num;
+    return res;
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 {
-    uint32_t demux_ctx;
-
-    if (entry == NULL) {
+    if ((entry == NULL) || (entry->next == NULL) ||
+        (entry->next->demux_ctx != entry->demux_ctx)) {
         return NULL;
     }
 
-    demux_ctx = entry->demux_ctx;
-
-    LL_SEARCH_SCALAR(entry->next, entry, demux_ctx, demux_ctx);
-
-    return entry;
+    return entry->next;
 }
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
@@ -39,11 +39,17 @@
 
 #define _MAX_L2_ADDR_LEN    (8U)
 
+#ifndef MODULE_GNRC_NETAPI_DIRECT
 #if ENABLE_DEBUG
 static char _stack[GNRC_IPV6_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_IPV6_STACK_SIZE];
 #endif
+#ifdef MODULE_GNRC_NETAPI_BATCH
+/* collects the packets passed on from a batch */
+static gnrc_netapi_batch_t _batch;
+#endif
+#endif
 
 #ifdef MODULE_FIB
 #include "net/fib.h"
@@ -53,6 +59,13 @@ static char _stack[GNRC_IPV6_STACK_SIZE];
  */
 static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
 
+#ifdef MODULE_FIB_TRIE
+/**
+ * @brief buffer to store the prefix trie of the IPv6 forwarding table
+ */
+static fib_trie_node_t _fib_trie[2 * GNRC_IPV6_FIB_TABLE_SIZE];
+#endif
+
 /**
  * @brief the IPv6 forwarding table
  */
@@ -69,22 +82,48 @@ static void _receive(gnrc_pktsnip_t *pkt);
  * prep_hdr: prepare header for sending (call to _fill_ipv6_hdr()), otherwise
  * assume it is already prepared */
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr);
+/* handles NIB timer events, returns false if msg is not one */
+static bool _handle_nib_event(msg_t *msg);
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+/* handles netapi commands in the context of the dispatching thread */
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+
+static gnrc_netreg_entry_cbd_t _cbd = { _netapi_cb, NULL };
+static gnrc_netreg_entry_t _me_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                               &_cbd);
+#else
+#ifdef MODULE_GNRC_NETAPI_BATCH
+/* handles the packets of GNRC_NETAPI_MSG_TYPE_SND_BATCH commands */
+static void _send_batched(gnrc_pktsnip_t *pkt);
+#endif
 /* Main event loop for IPv6 */
 static void *_event_loop(void *args);
+#endif
 
 /* Handles encapsulated IPv6 packets: http://tools.ietf.org/html/rfc2473 */
 static void _decapsulate(gnrc_pktsnip_t *pkt);
 
 kernel_pid_t gnrc_ipv6_init(void)
 {
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    /* register interest in all IPv6 packets, gnrc_ipv6_pid is set by the
+     * first network interface */
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_me_reg);
+#else
     if (gnrc_ipv6_pid == KERNEL_PID_UNDEF) {
         gnrc_ipv6_pid = thread_create(_stack, sizeof(_stack), GNRC_IPV6_PRIO,
                                       THREAD_CREATE_STACKTEST,
                                       _event_loop, NULL, "ipv6");
     }
+#endif
 
 #ifdef MODULE_FIB
     gnrc_ipv6_fib_table.data.entries = _fib_entries;
+#ifdef MODULE_FIB_TRIE
+    gnrc_ipv6_fib_table.trie = _fib_trie;
+#else
+    gnrc_ipv6_fib_table.trie = NULL;
+#endif
     gnrc_ipv6_fib_table.table_type = FIB_TABLE_TYPE_SH;
     gnrc_ipv6_fib_table.size = GNRC_IPV6_FIB_TABLE_SIZE;
     fib_init(&gnrc_ipv6_fib_table);
@@ -244,6 +283,64 @@ static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
     }
 }
 
+static bool _handle_nib_event(msg_t *msg)
+{
+    switch (msg->type) {
+        case GNRC_IPV6_NIB_SND_UC_NS:
+        case GNRC_IPV6_NIB_SND_MC_NS:
+        case GNRC_IPV6_NIB_SND_NA:
+        case GNRC_IPV6_NIB_SEARCH_RTR:
+        case GNRC_IPV6_NIB_REPLY_RS:
+        case GNRC_IPV6_NIB_SND_MC_RA:
+        case GNRC_IPV6_NIB_REACH_TIMEOUT:
+        case GNRC_IPV6_NIB_DELAY_TIMEOUT:
+        case GNRC_IPV6_NIB_ADDR_REG_TIMEOUT:
+        case GNRC_IPV6_NIB_ABR_TIMEOUT:
+        case GNRC_IPV6_NIB_PFX_TIMEOUT:
+        case GNRC_IPV6_NIB_RTR_TIMEOUT:
+        case GNRC_IPV6_NIB_RECALC_REACH_TIME:
+        case GNRC_IPV6_NIB_REREG_ADDRESS:
+        case GNRC_IPV6_NIB_ROUTE_TIMEOUT:
+            DEBUG("ipv6: NIB timer event received\n");
+            gnrc_ipv6_nib_handle_timer_event(msg->content.ptr, msg->type);
+            return true;
+        default:
+            return false;
+    }
+}
+
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+bool gnrc_ipv6_direct_handle_msg(msg_t *msg)
+{
+    bool res;
+
+    gnrc_netapi_direct_acquire();
+    res = _handle_nib_event(msg);
+    gnrc_netapi_direct_release();
+    return res;
+}
+
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    gnrc_netapi_direct_acquire();
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV called\n");
+            _receive(pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND called\n");
+            _send(pkt, true);
+            break;
+        default:
+            DEBUG("ipv6: operation not supported\n");
+            gnrc_pktbuf_release(pkt);
+            break;
+    }
+    gnrc_netapi_direct_release();
+}
+#else
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
@@ -255,6 +352,9 @@ static void *_event_loop(void *args)
 
     /* register interest in all IPv6 packets */
     gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me_reg);
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    gnrc_netapi_batch_enable(sched_active_pid);
+#endif
 
     /* preinitialize ACK */
     reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
@@ -275,6 +375,18 @@ static void *_event_loop(void *args)
                 _send(msg.content.ptr, true);
                 break;
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV_BATCH received\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _receive, &_batch);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND_BATCH received\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _send_batched, &_batch);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("ipv6: reply to unsupported get/set\n");
@@ -282,25 +394,8 @@ static void *_event_loop(void *args)
                 msg_reply(&msg, &reply);
                 break;
 
-            case GNRC_IPV6_NIB_SND_UC_NS:
-            case GNRC_IPV6_NIB_SND_MC_NS:
-            case GNRC_IPV6_NIB_SND_NA:
-            case GNRC_IPV6_NIB_SEARCH_RTR:
-            case GNRC_IPV6_NIB_REPLY_RS:
-            case GNRC_IPV6_NIB_SND_MC_RA:
-            case GNRC_IPV6_NIB_REACH_TIMEOUT:
-            case GNRC_IPV6_NIB_DELAY_TIMEOUT:
-            case GNRC_IPV6_NIB_ADDR_REG_TIMEOUT:
-            case GNRC_IPV6_NIB_ABR_TIMEOUT:
-            case GNRC_IPV6_NIB_PFX_TIMEOUT:
-            case GNRC_IPV6_NIB_RTR_TIMEOUT:
-            case GNRC_IPV6_NIB_RECALC_REACH_TIME:
-            case GNRC_IPV6_NIB_REREG_ADDRESS:
-            case GNRC_IPV6_NIB_ROUTE_TIMEOUT:
-                DEBUG("ipv6: NIB timer event received\n");
-                gnrc_ipv6_nib_handle_timer_event(msg.content.ptr, msg.type);
-                break;
             default:
+                _handle_nib_event(&msg);
                 break;
         }
     }
@@ -308,6 +403,14 @@ static void *_event_loop(void *args)
     return NULL;
 }
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+static void _send_batched(gnrc_pktsnip_t *pkt)
+{
+    _send(pkt, true);
+}
+#endif
+#endif
+
 static void _send_to_iface(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
     assert(netif != NULL);
@@ -647,10 +750,14 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
 
         DEBUG("ipv6: packet is addressed to myself => loopback\n");
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+        _receive(rcv_pkt);
+#else
         if (gnrc_netapi_receive(gnrc_ipv6_pid, rcv_pkt) < 1) {
             DEBUG("ipv6: unable to deliver packet\n");
             gnrc_pktbuf_release(rcv_pkt);
         }
+#endif
     }
     else {
         gnrc_ipv6_nib_nc_t nce;
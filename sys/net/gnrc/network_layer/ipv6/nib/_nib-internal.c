@@ -22,6 +22,7 @@
 #include "net/gnrc/ipv6/nib/nc.h"
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/netif/internal.h"
+#include "objpool.h"
 #include "random.h"
 
 #include "_nib-internal.h"
@@ -35,6 +36,8 @@ _nib_dr_entry_t *_prime_def_router = NULL;
 static clist_node_t _next_removable = { NULL };
 
 static _nib_onl_entry_t _nodes[GNRC_IPV6_NIB_NUMOF];
+static unsigned _nodes_used[OBJPOOL_BITMAP_NUMOF(GNRC_IPV6_NIB_NUMOF)];
+static objpool_t _nodes_pool = OBJPOOL_INIT(_nodes, _nodes_used);
 static _nib_offl_entry_t _dsts[GNRC_IPV6_NIB_OFFL_NUMOF];
 static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 
@@ -42,6 +45,53 @@ static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 static _nib_abr_entry_t _abrs[GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE
+/**
+ * @brief   Node of the prefix trie over the off-link entries
+ *
+ * Nodes without off-link entries are branch nodes and always have two
+ * children.
+ */
+typedef struct _offl_trie_node {
+    struct _offl_trie_node *child[2];   /**< sub-tries for next bit 0 and 1 */
+    _nib_offl_entry_t *dsts;            /**< off-link entries with exactly
+                                         *   this prefix */
+    ipv6_addr_t pfx;                    /**< prefix of the node */
+    uint8_t pfx_len;                    /**< length of the prefix in bits */
+} _offl_trie_node_t;
+
+/* a trie with n prefix nodes has at most n - 1 branch nodes */
+#define _OFFL_TRIE_NUMOF    (2 * GNRC_IPV6_NIB_OFFL_NUMOF)
+
+static _offl_trie_node_t _offl_trie[_OFFL_TRIE_NUMOF];
+static _offl_trie_node_t *_offl_trie_root = NULL;
+static _offl_trie_node_t *_offl_trie_free = NULL;
+/* links off-link entries with the same prefix, ordered by position in _dsts */
+static _nib_offl_entry_t *_offl_trie_next[GNRC_IPV6_NIB_OFFL_NUMOF];
+
+static inline unsigned _pfx_bit(const ipv6_addr_t *addr, unsigned idx)
+{
+    return (addr->u8[idx / 8] >> (7 - (idx % 8))) & 1;
+}
+
+static void _offl_trie_init(void);
+static void _offl_trie_add(_nib_offl_entry_t *dst);
+static void _offl_trie_remove(_nib_offl_entry_t *dst);
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
+
+/* open addressing hash index over _nodes, kept at a load factor of at most
+ * 1/2. A slot stores the position of an entry in _nodes + 1 (0 marks a free
+ * slot) */
+#define _ONL_IDX_NUMOF      (2 * GNRC_IPV6_NIB_NUMOF)
+
+#if GNRC_IPV6_NIB_NUMOF < UINT8_MAX
+typedef uint8_t _onl_idx_t;
+#else
+typedef uint16_t _onl_idx_t;
+#endif
+
+static _onl_idx_t _onl_idx[_ONL_IDX_NUMOF];
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 mutex_t _nib_mutex = MUTEX_INIT;
@@ -57,16 +107,101 @@ void _nib_init(void)
     _prime_def_router = NULL;
     _next_removable.next = NULL;
     memset(_nodes, 0, sizeof(_nodes));
+    objpool_init(&_nodes_pool, _nodes, sizeof(_nib_onl_entry_t),
+                 GNRC_IPV6_NIB_NUMOF, _nodes_used);
+    memset(_onl_idx, 0, sizeof(_onl_idx));
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_dsts, 0, sizeof(_dsts));
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 #endif  /* TEST_SUITES */
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE
+    _offl_trie_init();
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
 
+static inline unsigned _onl_idx_hash(const ipv6_addr_t *addr)
+{
+    /* the interface is not hashed so lookups with interface 0 still find
+     * all entries for addr */
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                    addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    return ((hash * 2654435761U) >> 16) % _ONL_IDX_NUMOF;
+}
+
+static inline unsigned _onl_idx_next(unsigned slot)
+{
+    return (slot + 1) % _ONL_IDX_NUMOF;
+}
+
+static void _onl_idx_add(const _nib_onl_entry_t *node)
+{
+    unsigned slot = _onl_idx_hash(&node->ipv6);
+
+    /* every entry is indexed at most once, so there is always a free slot */
+    while (_onl_idx[slot] != 0) {
+        slot = _onl_idx_next(slot);
+    }
+    _onl_idx[slot] = (_onl_idx_t)((node - _nodes) + 1);
+}
+
+/* must be called before _nib_onl_entry_t::ipv6 of an indexed entry changes */
+static void _onl_idx_remove(const _nib_onl_entry_t *node)
+{
+    const _onl_idx_t idx = (_onl_idx_t)((node - _nodes) + 1);
+    unsigned slot = _onl_idx_hash(&node->ipv6);
+
+    while (_onl_idx[slot] != idx) {
+        if (_onl_idx[slot] == 0) {
+            /* entry is not indexed */
+            return;
+        }
+        slot = _onl_idx_next(slot);
+    }
+    /* shift following entries of the probe sequence into the gap, so lookups
+     * can still stop at the first free slot */
+    for (unsigned next = _onl_idx_next(slot); _onl_idx[next] != 0;
+         next = _onl_idx_next(next)) {
+        unsigned home = _onl_idx_hash(&_nodes[_onl_idx[next] - 1].ipv6);
+
+        if (((next + _ONL_IDX_NUMOF - home) % _ONL_IDX_NUMOF) >=
+            ((next + _ONL_IDX_NUMOF - slot) % _ONL_IDX_NUMOF)) {
+            _onl_idx[slot] = _onl_idx[next];
+            slot = next;
+        }
+    }
+    _onl_idx[slot] = 0;
+}
+
+/* returns the first entry in _nodes with address addr that is either on
+ * exactly iface regardless of its mode (exact, as for _nib_onl_alloc()) or
+ * non-empty and on iface or interface 0 (as for _nib_onl_get()) */
+static _nib_onl_entry_t *_onl_idx_get(const ipv6_addr_t *addr, unsigned iface,
+                                      bool exact)
+{
+    _nib_onl_entry_t *res = NULL;
+
+    for (unsigned slot = _onl_idx_hash(addr); _onl_idx[slot] != 0;
+         slot = _onl_idx_next(slot)) {
+        _nib_onl_entry_t *node = &_nodes[_onl_idx[slot] - 1];
+        unsigned node_iface = _nib_onl_get_if(node);
+
+        if (((res == NULL) || (node < res)) &&
+            ((exact) ? (node_iface == iface)
+                     : ((node->mode != _EMPTY) && ((node_iface == 0) ||
+                                                   (iface == 0) ||
+                                                   (node_iface == iface)))) &&
+            ipv6_addr_equal(&node->ipv6, addr)) {
+            res = node;
+        }
+    }
+    return res;
+}
+
 static inline bool _addr_equals(const ipv6_addr_t *addr,
                                 const _nib_onl_entry_t *node)
 {
@@ -81,20 +216,38 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
     DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
           (addr == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, addr,
                                                      sizeof(addr_str)), iface);
-    for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
-        _nib_onl_entry_t *tmp = &_nodes[i];
-
-        if ((_nib_onl_get_if(tmp) == iface) && _addr_equals(addr, tmp)) {
-            /* exact match */
-            DEBUG("  %p is an exact match\n", (void *)tmp);
-            node = tmp;
-            break;
+    if ((addr != NULL) && (iface != 0) && !ipv6_addr_is_unspecified(addr)) {
+        /* entries on iface without an address also match (see
+         * _addr_equals()) */
+        _nib_onl_entry_t *noaddr = _onl_idx_get(&ipv6_addr_unspecified,
+                                                iface, true);
+
+        node = _onl_idx_get(addr, iface, true);
+        if ((noaddr != NULL) && ((node == NULL) || (noaddr < node))) {
+            node = noaddr;
         }
-        if ((node == NULL) && (tmp->mode == _EMPTY)) {
-            DEBUG("  using %p\n", (void *)node);
-            node = tmp;
+    }
+    else {
+        /* cleared entries are not indexed, so fall back to linear search */
+        for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+            _nib_onl_entry_t *tmp = &_nodes[i];
+
+            if ((_nib_onl_get_if(tmp) == iface) && _addr_equals(addr, tmp)) {
+                node = tmp;
+                break;
+            }
         }
     }
+    if (node != NULL) {
+        /* exact match */
+        DEBUG("  %p is an exact match\n", (void *)node);
+        /* the linear search above also matches cleared entries */
+        objpool_take(&_nodes_pool, node);
+    }
+    else {
+        node = objpool_alloc(&_nodes_pool);
+        DEBUG("  using %p\n", (void *)node);
+    }
     if (node != NULL) {
         _override_node(addr, iface, node);
     }
@@ -139,6 +292,8 @@ static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
             /* call _nib_nc_remove to remove timers from _evtimer */
             _nib_nc_remove(tmp);
             res = tmp;
+            /* _nib_nc_remove() released the entry, so take it back */
+            objpool_take(&_nodes_pool, res);
             _override_node(addr, iface, res);
             /* cstate masked in _nib_nc_add() already */
             res->info |= cstate;
@@ -200,24 +355,35 @@ _nib_onl_entry_t *_nib_onl_iter(const _nib_onl_entry_t *last)
 
 _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
 {
+    _nib_onl_entry_t *node;
+
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
-    for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
-        _nib_onl_entry_t *node = &_nodes[i];
-
-        if ((node->mode != _EMPTY) &&
-            /* either requested or current interface undefined or
-             * interfaces equal */
-            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
-             (_nib_onl_get_if(node) == iface)) &&
-            ipv6_addr_equal(&node->ipv6, addr)) {
-            DEBUG("  Found %p\n", (void *)node);
-            return node;
+    /* either requested or current interface undefined or interfaces equal */
+    node = _onl_idx_get(addr, iface, false);
+#if ENABLE_DEBUG
+    if (node != NULL) {
+        DEBUG("  Found %p\n", (void *)node);
+    }
+    else {
+        DEBUG("  No suitable entry found\n");
+    }
+#endif  /* ENABLE_DEBUG */
+    return node;
+}
+
+bool _nib_onl_clear(_nib_onl_entry_t *node)
+{
+    if (node->mode == _EMPTY) {
+        _onl_idx_remove(node);
+        memset(node, 0, sizeof(_nib_onl_entry_t));
+        if (objpool_is_used(&_nodes_pool, node)) {
+            objpool_free(&_nodes_pool, node);
         }
+        return true;
     }
-    DEBUG("  No suitable entry found\n");
-    return NULL;
+    return false;
 }
 
 void _nib_nc_set_reachable(_nib_onl_entry_t *node)
@@ -463,7 +629,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             /* exact match (or next hop address was previously unset) */
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
+                _onl_idx_remove(tmp_node);
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+                _onl_idx_add(tmp_node);
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -484,6 +652,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE
+        _offl_trie_add(dst);
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
     }
     return dst;
 }
@@ -515,6 +686,9 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE
+        _offl_trie_remove(dst);
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -538,6 +712,35 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
     return (entry >= _dsts) && _in_dsts(entry);
 }
 
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE
+static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+    _offl_trie_node_t *node = _offl_trie_root;
+
+    DEBUG("nib: get match for destination %s from NIB\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    while ((node != NULL) &&
+           (ipv6_addr_match_prefix(&node->pfx, dst) >= node->pfx_len)) {
+        /* first entry in _dsts with this prefix wins, as with linear search */
+        for (_nib_offl_entry_t *entry = node->dsts; entry != NULL;
+             entry = _offl_trie_next[entry - _dsts]) {
+            if (entry->mode != _EMPTY) {
+                DEBUG("nib: best match so far %s/%u\n",
+                      ipv6_addr_to_str(addr_str, &entry->pfx,
+                                       sizeof(addr_str)), entry->pfx_len);
+                res = entry;
+                break;
+            }
+        }
+        if (node->pfx_len >= IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        node = node->child[_pfx_bit(dst, node->pfx_len)];
+    }
+    return res;
+}
+#else   /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
     _nib_offl_entry_t *res = NULL;
@@ -566,6 +769,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
     }
     return res;
 }
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
 {
@@ -785,11 +989,13 @@ _nib_offl_entry_t *_nib_pl_add(unsigned iface,
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node)
 {
+    _onl_idx_remove(node);
     _nib_onl_clear(node);
     if (addr != NULL) {
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
     _nib_onl_set_if(node, iface);
+    _onl_idx_add(node);
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
@@ -821,4 +1027,130 @@ uint32_t _evtimer_lookup(const void *ctx, uint16_t type)
     return UINT32_MAX;
 }
 
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE
+static void _offl_trie_init(void)
+{
+    _offl_trie_root = NULL;
+    _offl_trie_free = NULL;
+    for (unsigned i = 0; i < _OFFL_TRIE_NUMOF; i++) {
+        _offl_trie[i].child[0] = _offl_trie_free;
+        _offl_trie_free = &_offl_trie[i];
+    }
+}
+
+static _offl_trie_node_t *_offl_trie_node_alloc(const ipv6_addr_t *pfx,
+                                                unsigned pfx_len)
+{
+    _offl_trie_node_t *node = _offl_trie_free;
+
+    /* trie is dimensioned to hold all possible off-link entries */
+    assert(node != NULL);
+    _offl_trie_free = node->child[0];
+    memset(node, 0, sizeof(_offl_trie_node_t));
+    ipv6_addr_init_prefix(&node->pfx, pfx, pfx_len);
+    node->pfx_len = pfx_len;
+    return node;
+}
+
+static void _offl_trie_node_free(_offl_trie_node_t *node)
+{
+    node->dsts = NULL;
+    node->child[0] = _offl_trie_free;
+    _offl_trie_free = node;
+}
+
+static void _offl_trie_add_dst(_offl_trie_node_t *node, _nib_offl_entry_t *dst)
+{
+    _nib_offl_entry_t **ptr = &node->dsts;
+
+    while ((*ptr != NULL) && (*ptr < dst)) {
+        ptr = &_offl_trie_next[*ptr - _dsts];
+    }
+    _offl_trie_next[dst - _dsts] = *ptr;
+    *ptr = dst;
+}
+
+static void _offl_trie_add(_nib_offl_entry_t *dst)
+{
+    _offl_trie_node_t **link = &_offl_trie_root;
+
+    while (*link != NULL) {
+        _offl_trie_node_t *node = *link, *new_node;
+        unsigned match = ipv6_addr_match_prefix(&node->pfx, &dst->pfx);
+
+        if (match > node->pfx_len) {
+            match = node->pfx_len;
+        }
+        if (match > dst->pfx_len) {
+            match = dst->pfx_len;
+        }
+        if (match == node->pfx_len) {
+            if (node->pfx_len == dst->pfx_len) {
+                _offl_trie_add_dst(node, dst);
+                return;
+            }
+            link = &node->child[_pfx_bit(&dst->pfx, node->pfx_len)];
+            continue;
+        }
+        if (match == dst->pfx_len) {
+            /* prefix of dst is a prefix of node: insert dst above node */
+            new_node = _offl_trie_node_alloc(&dst->pfx, dst->pfx_len);
+            _offl_trie_add_dst(new_node, dst);
+        }
+        else {
+            /* prefixes diverge at bit match: insert branch above node */
+            _offl_trie_node_t *leaf = _offl_trie_node_alloc(&dst->pfx,
+                                                            dst->pfx_len);
+
+            _offl_trie_add_dst(leaf, dst);
+            new_node = _offl_trie_node_alloc(&dst->pfx, match);
+            new_node->child[_pfx_bit(&dst->pfx, match)] = leaf;
+        }
+        new_node->child[_pfx_bit(&node->pfx, match)] = node;
+        *link = new_node;
+        return;
+    }
+    *link = _offl_trie_node_alloc(&dst->pfx, dst->pfx_len);
+    _offl_trie_add_dst(*link, dst);
+}
+
+static void _offl_trie_remove(_nib_offl_entry_t *dst)
+{
+    _offl_trie_node_t **parent_link = NULL, **link = &_offl_trie_root;
+    _offl_trie_node_t *node;
+    _nib_offl_entry_t **ptr;
+
+    while (((node = *link) != NULL) && (node->pfx_len < dst->pfx_len)) {
+        parent_link = link;
+        link = &node->child[_pfx_bit(&dst->pfx, node->pfx_len)];
+    }
+    if (node == NULL) {
+        /* dst was never added, e.g. since it has no prefix yet */
+        return;
+    }
+    for (ptr = &node->dsts; (*ptr != NULL) && (*ptr != dst);
+         ptr = &_offl_trie_next[*ptr - _dsts]) {}
+    if (*ptr == NULL) {
+        return;
+    }
+    *ptr = _offl_trie_next[dst - _dsts];
+    _offl_trie_next[dst - _dsts] = NULL;
+    if ((node->dsts != NULL) ||
+        ((node->child[0] != NULL) && (node->child[1] != NULL))) {
+        /* node still has entries or stays as branch node */
+        return;
+    }
+    *link = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+    _offl_trie_node_free(node);
+    if ((*link == NULL) && (parent_link != NULL) &&
+        ((*parent_link)->dsts == NULL)) {
+        /* parent is a branch node with only one child left: collapse it */
+        node = *parent_link;
+        *parent_link = (node->child[0] != NULL) ? node->child[0]
+                                                : node->child[1];
+        _offl_trie_node_free(node);
+    }
+}
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
+
 /** @} */
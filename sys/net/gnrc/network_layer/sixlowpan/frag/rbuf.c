@@ -22,6 +22,7 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/sixlowpan.h"
+#include "objpool.h"
 #include "thread.h"
 #include "xtimer.h"
 #include "utlist.h"
@@ -29,6 +30,8 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifndef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+
 /* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
  * MAC payload size - fragment header. */
 #ifndef GNRC_SIXLOWPAN_FRAG_SIZE
@@ -43,8 +46,11 @@
 #endif
 
 static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+static unsigned rbuf_int_used[OBJPOOL_BITMAP_NUMOF(RBUF_INT_SIZE)];
+static objpool_t rbuf_int_pool = OBJPOOL_INIT(rbuf_int, rbuf_int_used);
 
 static rbuf_t rbuf[RBUF_SIZE];
+static gnrc_sixlowpan_frag_rbuf_stats_t rbuf_stats;
 
 static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 
@@ -134,6 +140,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     while (ptr != NULL) {
         if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
             DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
+            rbuf_stats.overlaps++;
             gnrc_pktbuf_release(entry->pkt);
             _rbuf_rem(entry);
 
@@ -176,6 +183,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         new_netif_hdr->lqi = netif_hdr->lqi;
         new_netif_hdr->rssi = netif_hdr->rssi;
         LL_APPEND(entry->pkt, netif);
+        rbuf_stats.datagrams++;
 
         if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL,
                                           entry->pkt)) {
@@ -187,6 +195,11 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     }
 }
 
+void gnrc_sixlowpan_frag_rbuf_get_stats(gnrc_sixlowpan_frag_rbuf_stats_t *stats)
+{
+    *stats = rbuf_stats;
+}
+
 static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
 {
     /* start and ends are both inclusive, so using <= for both */
@@ -196,13 +209,7 @@ static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, ui
 
 static rbuf_int_t *_rbuf_int_get_free(void)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
-    }
-
-    return NULL;
+    return objpool_alloc(&rbuf_int_pool);
 }
 
 static void _rbuf_rem(rbuf_t *entry)
@@ -210,9 +217,7 @@ static void _rbuf_rem(rbuf_t *entry)
     while (entry->ints != NULL) {
         rbuf_int_t *next = entry->ints->next;
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
+        objpool_free(&rbuf_int_pool, entry->ints);
         entry->ints = next;
     }
 
@@ -264,6 +269,7 @@ static void _rbuf_gc(void)
                                          l2addr_str),
                   (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
 
+            rbuf_stats.timeouts++;
             gnrc_pktbuf_release(rbuf[i].pkt);
             _rbuf_rem(&(rbuf[i]));
         }
@@ -312,6 +318,7 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
         assert(oldest != NULL);
         assert(oldest->pkt != NULL); /* if oldest->pkt == NULL, res must not be NULL */
         DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
+        rbuf_stats.evictions++;
         gnrc_pktbuf_release(oldest->pkt);
         _rbuf_rem(oldest);
         res = oldest;
@@ -343,5 +350,8 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
 
     return res;
 }
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
 
 /** @} */
@@ -14,6 +14,10 @@
  * @internal
  * @brief   6LoWPAN reassembly buffer
  *
+ * rbuf.c records received fragments as a list of intervals per datagram.
+ * With the `gnrc_sixlowpan_frag_rbuf_hash` module rbuf_hash.c replaces it,
+ * finding datagrams by hash and recording fragments in a bitmap.
+ *
  * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
  */
 #ifndef RBUF_H
@@ -31,8 +35,12 @@ extern "C" {
 #endif
 
 #define RBUF_L2ADDR_MAX_LEN (8U)               /**< maximum length for link-layer addresses */
+#ifndef RBUF_SIZE
 #define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
+#endif
+#ifndef RBUF_TIMEOUT
 #define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
+#endif
 
 /**
  * @brief   Fragment intervals to identify limits of fragments.
@@ -0,0 +1,469 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Hash indexed 6LoWPAN reassembly buffer
+ *
+ * Entries are found through a hash over (source, destination, size, tag) and
+ * kept in a list ordered by the arrival of their last fragment, so timed out
+ * entries and the oldest entry are found without scanning the buffer. The
+ * received parts of a datagram are recorded in a bitmap of 8-byte units, the
+ * granularity of fragment offsets, instead of a list of intervals.
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "rbuf.h"
+#include "bitfield.h"
+#include "net/ipv6.h"
+#include "net/ipv6/hdr.h"
+#include "net/gnrc.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
+#include "utlist.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH
+
+/**
+ * @brief   Number of hash buckets
+ */
+#ifndef RBUF_HASH_SIZE
+#define RBUF_HASH_SIZE      (2 * RBUF_SIZE)
+#endif
+
+/**
+ * @brief   Number of 8-byte units of the largest datagram
+ */
+#define RBUF_UNITS          ((SIXLOWPAN_FRAG_SIZE_MASK + 8) / 8)
+
+#define RBUF_NONE           (UINT8_MAX) /**< no entry */
+
+/* entries are referenced by uint8_t indices, RBUF_NONE included */
+#if RBUF_SIZE >= RBUF_NONE
+#error "RBUF_SIZE must be smaller than 255 with gnrc_sixlowpan_frag_rbuf_hash"
+#endif
+
+/* hash buckets are referenced by uint16_t indices */
+#if RBUF_HASH_SIZE > (UINT16_MAX + 1)
+#error "RBUF_HASH_SIZE must not exceed 65536 with gnrc_sixlowpan_frag_rbuf_hash"
+#endif
+
+/**
+ * @brief   An entry in the hash indexed reassembly buffer
+ *
+ * @see rbuf_t
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;                /**< the reassembled packet in packet
+                                         *   buffer, NULL if entry is unused */
+    uint32_t arrival;                   /**< time in microseconds of arrival
+                                         *   of last received fragment */
+    uint8_t src[RBUF_L2ADDR_MAX_LEN];   /**< source address */
+    uint8_t dst[RBUF_L2ADDR_MAX_LEN];   /**< destination address */
+    uint8_t src_len;                    /**< length of source address */
+    uint8_t dst_len;                    /**< length of destination address */
+    uint16_t tag;                       /**< the datagram's tag */
+    uint16_t cur_size;                  /**< the datagram's current size */
+    uint16_t bucket;                    /**< hash bucket of the entry */
+    uint8_t next;                       /**< next entry in the hash bucket or
+                                         *   in the free list */
+    uint8_t older;                      /**< entry that arrived before */
+    uint8_t newer;                      /**< entry that arrived after */
+    BITFIELD(units, RBUF_UNITS);        /**< received 8-byte units */
+} rbuf_hash_t;
+
+static rbuf_hash_t rbuf[RBUF_SIZE];
+static uint8_t rbuf_buckets[RBUF_HASH_SIZE];
+static uint8_t rbuf_free = RBUF_NONE;
+static uint8_t rbuf_oldest = RBUF_NONE;
+static uint8_t rbuf_newest = RBUF_NONE;
+static gnrc_sixlowpan_frag_rbuf_stats_t rbuf_stats;
+
+static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
+
+/* ------------------------------------
+ * internal function definitions
+ * ------------------------------------*/
+/* links all entries into the free list on first use */
+static void _rbuf_init(void);
+/* computes the hash bucket of a datagram */
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len,
+                           size_t size, uint16_t tag);
+/* removes entry from its bucket, the arrival list and the reassembly buffer */
+static void _rbuf_rem(rbuf_hash_t *entry);
+/* appends entry to the arrival list */
+static void _rbuf_link_newest(rbuf_hash_t *entry);
+/* removes entry from the arrival list */
+static void _rbuf_unlink_arrival(rbuf_hash_t *entry);
+/* moves entry to the end of the arrival list */
+static void _rbuf_touch(rbuf_hash_t *entry, uint32_t now_usec);
+/* marks the units of a fragment as received, returns false on overlap */
+static bool _rbuf_update_units(rbuf_hash_t *entry, uint16_t offset,
+                               size_t frag_size, bool *dup);
+/* removes timed out entries */
+static void _rbuf_gc(void);
+/* removes the entry whose last fragment arrived first */
+static void _rbuf_evict_oldest(void);
+/* gets an entry identified by its tupel */
+static rbuf_hash_t *_rbuf_get(const void *src, size_t src_len,
+                              const void *dst, size_t dst_len,
+                              size_t size, uint16_t tag);
+
+void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+              size_t frag_size, size_t offset)
+{
+    rbuf_hash_t *entry;
+    unsigned int data_offset = 0;
+    size_t original_size = frag_size;
+    sixlowpan_frag_t *frag = pkt->data;
+    uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
+    bool dup;
+
+    _rbuf_gc();
+    entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
+                      gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
+                      byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK,
+                      byteorder_ntohs(frag->tag));
+
+    if (entry == NULL) {
+        DEBUG("6lo rbuf: reassembly buffer full.\n");
+        return;
+    }
+
+    /* dispatches in the first fragment are ignored */
+    if (offset == 0) {
+        if (data[0] == SIXLOWPAN_UNCOMP) {
+            data++;             /* skip 6LoWPAN dispatch */
+            frag_size--;
+        }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+        else if (sixlowpan_iphc_is(data)) {
+            size_t iphc_len, nh_len = 0;
+            iphc_len = gnrc_sixlowpan_iphc_decode(&entry->pkt, pkt, entry->pkt->size,
+                                                  sizeof(sixlowpan_frag_t), &nh_len);
+            if (iphc_len == 0) {
+                DEBUG("6lo rfrag: could not decode IPHC dispatch\n");
+                gnrc_pktbuf_release(entry->pkt);
+                _rbuf_rem(entry);
+                return;
+            }
+            data += iphc_len;       /* take remaining data as data */
+            frag_size -= iphc_len;  /* and reduce frag size by IPHC dispatch length */
+            /* but add IPv6 header + next header lengths */
+            frag_size += sizeof(ipv6_hdr_t) + nh_len;
+            /* start copying after IPv6 header and next headers */
+            data_offset += sizeof(ipv6_hdr_t) + nh_len;
+        }
+#endif
+    }
+    else {
+        data++; /* FRAGN header is one byte longer (offset) */
+    }
+
+    if ((frag_size == 0) || ((offset + frag_size) > entry->pkt->size)) {
+        DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
+        gnrc_pktbuf_release(entry->pkt);
+        _rbuf_rem(entry);
+        return;
+    }
+
+    if (!_rbuf_update_units(entry, offset, frag_size, &dup)) {
+        DEBUG("6lo rfrag: overlapping fragments, discarding datagram\n");
+        rbuf_stats.overlaps++;
+        gnrc_pktbuf_release(entry->pkt);
+        _rbuf_rem(entry);
+
+        /* "A fresh reassembly may be commenced with the most recently
+         * received link fragment"
+         * https://tools.ietf.org/html/rfc4944#section-5.3 */
+        rbuf_add(netif_hdr, pkt, original_size, offset);
+
+        return;
+    }
+
+    if (!dup) {
+        DEBUG("6lo rbuf: add fragment data\n");
+        entry->cur_size += (uint16_t)frag_size;
+        memcpy(((uint8_t *)entry->pkt->data) + offset + data_offset, data,
+               frag_size - data_offset);
+    }
+
+    if (entry->cur_size == entry->pkt->size) {
+        gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(entry->src, entry->src_len,
+                                                     entry->dst, entry->dst_len);
+        gnrc_pktsnip_t *datagram = entry->pkt;
+
+        _rbuf_rem(entry);
+        if (netif == NULL) {
+            DEBUG("6lo rbuf: error allocating netif header\n");
+            gnrc_pktbuf_release(datagram);
+            return;
+        }
+
+        /* copy the transmit information of the latest fragment into the newly
+         * created header to have some link_layer information. The link_layer
+         * info of the previous fragments is discarded.
+         */
+        gnrc_netif_hdr_t *new_netif_hdr = netif->data;
+        new_netif_hdr->if_pid = netif_hdr->if_pid;
+        new_netif_hdr->flags = netif_hdr->flags;
+        new_netif_hdr->lqi = netif_hdr->lqi;
+        new_netif_hdr->rssi = netif_hdr->rssi;
+        LL_APPEND(datagram, netif);
+        rbuf_stats.datagrams++;
+
+        if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL,
+                                          datagram)) {
+            DEBUG("6lo rbuf: No receivers for this packet found\n");
+            gnrc_pktbuf_release(datagram);
+        }
+    }
+}
+
+void gnrc_sixlowpan_frag_rbuf_get_stats(gnrc_sixlowpan_frag_rbuf_stats_t *stats)
+{
+    *stats = rbuf_stats;
+}
+
+static void _rbuf_init(void)
+{
+    static bool initialized = false;
+
+    if (initialized) {
+        return;
+    }
+    memset(rbuf_buckets, RBUF_NONE, sizeof(rbuf_buckets));
+    for (unsigned i = 0; i < RBUF_SIZE; i++) {
+        rbuf[i].next = (i + 1 < RBUF_SIZE) ? (uint8_t)(i + 1) : RBUF_NONE;
+    }
+    rbuf_free = 0;
+    initialized = true;
+}
+
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len,
+                           size_t size, uint16_t tag)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash ^ src[i]) * 16777619U;
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash ^ dst[i]) * 16777619U;
+    }
+    hash = (hash ^ (tag & 0xff)) * 16777619U;
+    hash = (hash ^ (tag >> 8)) * 16777619U;
+    hash = (hash ^ (size & 0xff)) * 16777619U;
+    hash = (hash ^ (size >> 8)) * 16777619U;
+    return hash % RBUF_HASH_SIZE;
+}
+
+static void _rbuf_unlink_arrival(rbuf_hash_t *entry)
+{
+    if (entry->older == RBUF_NONE) {
+        rbuf_oldest = entry->newer;
+    }
+    else {
+        rbuf[entry->older].newer = entry->newer;
+    }
+    if (entry->newer == RBUF_NONE) {
+        rbuf_newest = entry->older;
+    }
+    else {
+        rbuf[entry->newer].older = entry->older;
+    }
+}
+
+static void _rbuf_link_newest(rbuf_hash_t *entry)
+{
+    uint8_t idx = (uint8_t)(entry - rbuf);
+
+    entry->older = rbuf_newest;
+    entry->newer = RBUF_NONE;
+    if (rbuf_newest == RBUF_NONE) {
+        rbuf_oldest = idx;
+    }
+    else {
+        rbuf[rbuf_newest].newer = idx;
+    }
+    rbuf_newest = idx;
+}
+
+static void _rbuf_touch(rbuf_hash_t *entry, uint32_t now_usec)
+{
+    entry->arrival = now_usec;
+    if (rbuf_newest != (uint8_t)(entry - rbuf)) {
+        _rbuf_unlink_arrival(entry);
+        _rbuf_link_newest(entry);
+    }
+}
+
+static void _rbuf_rem(rbuf_hash_t *entry)
+{
+    uint8_t idx = (uint8_t)(entry - rbuf);
+    uint8_t *ptr = &rbuf_buckets[entry->bucket];
+
+    while (*ptr != idx) {
+        assert(*ptr != RBUF_NONE);
+        ptr = &rbuf[*ptr].next;
+    }
+    *ptr = entry->next;
+    _rbuf_unlink_arrival(entry);
+    entry->pkt = NULL;
+    entry->next = rbuf_free;
+    rbuf_free = idx;
+}
+
+static bool _rbuf_update_units(rbuf_hash_t *entry, uint16_t offset,
+                               size_t frag_size, bool *dup)
+{
+    unsigned first = offset / 8;
+    unsigned last = (offset + frag_size - 1) / 8;
+    unsigned received = 0;
+
+    for (unsigned i = first; i <= last; i++) {
+        if (bf_isset(entry->units, i)) {
+            received++;
+        }
+    }
+    /* a fragment that was received completely before is a duplicate, one
+     * that was received in parts overlaps another fragment */
+    *dup = (received == (last - first + 1));
+    if ((received > 0) && !*dup) {
+        return false;
+    }
+    for (unsigned i = first; i <= last; i++) {
+        bf_set(entry->units, i);
+    }
+    DEBUG("6lo rfrag: add units (%u, %u) to entry (%s, ", first, last,
+          gnrc_netif_addr_to_str(entry->src, entry->src_len, l2addr_str));
+    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->dst, entry->dst_len,
+                                                  l2addr_str),
+          (unsigned)entry->pkt->size, entry->tag);
+    return true;
+}
+
+static void _rbuf_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    /* the arrival list is ordered, so stop at the first entry in time */
+    while ((rbuf_oldest != RBUF_NONE) &&
+           ((now_usec - rbuf[rbuf_oldest].arrival) > RBUF_TIMEOUT)) {
+        rbuf_hash_t *entry = &rbuf[rbuf_oldest];
+
+        DEBUG("6lo rfrag: entry (%s, ",
+              gnrc_netif_addr_to_str(entry->src, entry->src_len, l2addr_str));
+        DEBUG("%s, %u, %u) timed out\n",
+              gnrc_netif_addr_to_str(entry->dst, entry->dst_len, l2addr_str),
+              (unsigned)entry->pkt->size, entry->tag);
+        rbuf_stats.timeouts++;
+        gnrc_pktbuf_release(entry->pkt);
+        _rbuf_rem(entry);
+    }
+}
+
+static void _rbuf_evict_oldest(void)
+{
+    rbuf_hash_t *oldest = &rbuf[rbuf_oldest];
+
+    DEBUG("6lo rfrag: remove oldest entry\n");
+    rbuf_stats.evictions++;
+    gnrc_pktbuf_release(oldest->pkt);
+    _rbuf_rem(oldest);
+}
+
+static rbuf_hash_t *_rbuf_get(const void *src, size_t src_len,
+                              const void *dst, size_t dst_len,
+                              size_t size, uint16_t tag)
+{
+    rbuf_hash_t *res;
+    uint32_t now_usec = xtimer_now_usec();
+    unsigned bucket = _rbuf_hash(src, src_len, dst, dst_len, size, tag);
+    gnrc_pktsnip_t *pkt;
+
+    _rbuf_init();
+    for (uint8_t i = rbuf_buckets[bucket]; i != RBUF_NONE; i = rbuf[i].next) {
+        res = &rbuf[i];
+        if ((res->pkt->size == size) && (res->tag == tag) &&
+            (res->src_len == src_len) && (res->dst_len == dst_len) &&
+            (memcmp(res->src, src, src_len) == 0) &&
+            (memcmp(res->dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+                  gnrc_netif_addr_to_str(res->src, res->src_len, l2addr_str));
+            DEBUG("%s, %u, %u) found\n",
+                  gnrc_netif_addr_to_str(res->dst, res->dst_len, l2addr_str),
+                  (unsigned)res->pkt->size, res->tag);
+            _rbuf_touch(res, now_usec);
+            return res;
+        }
+    }
+
+    if (rbuf_free == RBUF_NONE) {
+        DEBUG("6lo rfrag: reassembly buffer full\n");
+        _rbuf_evict_oldest();
+    }
+    pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6);
+    /* under packet buffer pressure, give up the oldest datagram. Only one and
+     * only if the datagram could fit at all, so a bogus size can not discard
+     * all other reassemblies. */
+    if ((pkt == NULL) && (size < GNRC_PKTBUF_SIZE) &&
+        (rbuf_oldest != RBUF_NONE)) {
+        _rbuf_evict_oldest();
+        pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6);
+    }
+    if (pkt == NULL) {
+        DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+        return NULL;
+    }
+
+    res = &rbuf[rbuf_free];
+    rbuf_free = res->next;
+    res->pkt = pkt;
+    *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
+                                         * look-ups */
+    memcpy(res->src, src, src_len);
+    memcpy(res->dst, dst, dst_len);
+    res->src_len = src_len;
+    res->dst_len = dst_len;
+    res->tag = tag;
+    res->cur_size = 0;
+    memset(res->units, 0, sizeof(res->units));
+    res->bucket = (uint16_t)bucket;
+    res->next = rbuf_buckets[bucket];
+    rbuf_buckets[bucket] = (uint8_t)(res - rbuf);
+    res->arrival = now_usec;
+    _rbuf_link_newest(res);
+
+    DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+          gnrc_netif_addr_to_str(res->src, res->src_len, l2addr_str));
+    DEBUG("%s, %u, %u) created\n",
+          gnrc_netif_addr_to_str(res->dst, res->dst_len, l2addr_str),
+          (unsigned)res->pkt->size, res->tag);
+
+    return res;
+}
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_RBUF_HASH */
+
+/** @} */
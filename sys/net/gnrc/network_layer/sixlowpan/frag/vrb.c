@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+
+#define VRB_L2ADDR_MAX_LEN  (8U)    /**< maximum length for link-layer addresses */
+
+/**
+ * @brief   An entry in the virtual reassembly buffer
+ *
+ * A datagram is identified by the interface it is received on, its
+ * link-layer source, its size and its tag.
+ */
+typedef struct {
+    gnrc_netif_t *out_netif;                /**< interface to forward to,
+                                             *   NULL if entry is unused */
+    uint32_t arrival;                       /**< time in microseconds of
+                                             *   arrival of last fragment */
+    uint8_t src[VRB_L2ADDR_MAX_LEN];        /**< source address */
+    uint8_t out_dst[VRB_L2ADDR_MAX_LEN];    /**< address of the next hop */
+    kernel_pid_t in_pid;                    /**< receiving interface */
+    uint8_t src_len;                        /**< length of vrb_t::src */
+    uint8_t out_dst_len;                    /**< length of vrb_t::out_dst */
+    uint16_t tag;                           /**< the datagram's tag */
+    uint16_t out_tag;                       /**< tag towards the next hop */
+    uint16_t size;                          /**< the datagram's size */
+    uint16_t forwarded;                     /**< bytes of the uncompressed
+                                             *   datagram forwarded */
+} vrb_t;
+
+static vrb_t _vrb[GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static gnrc_sixlowpan_frag_vrb_stats_t _stats;
+
+static void _vrb_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if ((_vrb[i].out_netif != NULL) &&
+            ((now_usec - _vrb[i].arrival) > GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT)) {
+            DEBUG("6lo vrb: entry (%u, %u) timed out\n",
+                  (unsigned)_vrb[i].size, _vrb[i].tag);
+            _vrb[i].out_netif = NULL;
+            _stats.timeouts++;
+        }
+    }
+}
+
+static vrb_t *_vrb_get(gnrc_netif_hdr_t *hdr, uint16_t size,
+                       uint16_t tag)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if ((_vrb[i].out_netif != NULL) && (_vrb[i].in_pid == hdr->if_pid) &&
+            (_vrb[i].size == size) && (_vrb[i].tag == tag) &&
+            (_vrb[i].src_len == hdr->src_l2addr_len) &&
+            (memcmp(_vrb[i].src, gnrc_netif_hdr_get_src_addr(hdr),
+                    hdr->src_l2addr_len) == 0)) {
+            return &_vrb[i];
+        }
+    }
+    return NULL;
+}
+
+static vrb_t *_vrb_get_free(void)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if (_vrb[i].out_netif == NULL) {
+            return &_vrb[i];
+        }
+    }
+    return NULL;
+}
+
+/* sends fragment payload `frag` to the next hop of `entry` and accounts
+ * `frag_size` bytes of the uncompressed datagram */
+static void _send(vrb_t *entry, gnrc_pktsnip_t *frag, size_t frag_size)
+{
+    gnrc_netif_t *netif = entry->out_netif;
+    gnrc_pktsnip_t *netif_hdr = gnrc_netif_hdr_build(NULL, 0, entry->out_dst,
+                                                     entry->out_dst_len);
+
+    entry->arrival = xtimer_now_usec();
+    entry->forwarded += frag_size;
+    if (entry->forwarded >= entry->size) {
+        DEBUG("6lo vrb: datagram (%u, %u) forwarded completely\n",
+              (unsigned)entry->size, entry->tag);
+        entry->out_netif = NULL;
+    }
+    if (netif_hdr == NULL) {
+        DEBUG("6lo vrb: unable to allocate netif header\n");
+        gnrc_pktbuf_release(frag);
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = netif->pid;
+    LL_PREPEND(frag, netif_hdr);
+    if (gnrc_netapi_send(netif->pid, frag) < 1) {
+        DEBUG("6lo vrb: unable to forward fragment\n");
+        gnrc_pktbuf_release(frag);
+        return;
+    }
+    _stats.fragments++;
+}
+
+/* decompresses the IPv6 header of a first fragment into `ipv6` and returns
+ * the length of the compressed headers or 0 if it can't be forwarded as is */
+static size_t _decode(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t **ipv6,
+                      uint16_t size, size_t *nh_len)
+{
+    uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
+    size_t data_len = pkt->size - sizeof(sixlowpan_frag_t);
+
+    *nh_len = 0;
+    if ((data_len > sizeof(ipv6_hdr_t)) && (data[0] == SIXLOWPAN_UNCOMP)) {
+        memcpy((*ipv6)->data, data + 1, sizeof(ipv6_hdr_t));
+        return 1 + sizeof(ipv6_hdr_t);
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    if ((data_len > 0) && sixlowpan_iphc_is(data)) {
+        return gnrc_sixlowpan_iphc_decode(ipv6, pkt, size,
+                                          sizeof(sixlowpan_frag_t), nh_len);
+    }
+#else
+    (void)size;
+#endif
+    return 0;
+}
+
+static gnrc_pktsnip_t *_build_1st(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *ipv6,
+                                  size_t hdr_len, size_t nh_len,
+                                  vrb_t *entry)
+{
+    uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
+    size_t data_len = pkt->size - sizeof(sixlowpan_frag_t);
+    gnrc_pktsnip_t *frag;
+    sixlowpan_frag_t *frag_hdr;
+
+    if (data[0] == SIXLOWPAN_UNCOMP) {
+        /* keep the datagram uncompressed and only update the hop limit */
+        frag = gnrc_pktbuf_add(NULL, pkt->data, pkt->size,
+                               GNRC_NETTYPE_SIXLOWPAN);
+        if (frag == NULL) {
+            return NULL;
+        }
+        memcpy(((uint8_t *)frag->data) + sizeof(sixlowpan_frag_t) + 1,
+               ipv6->data, sizeof(ipv6_hdr_t));
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    else {
+        gnrc_pktsnip_t *netif_hdr, *rest;
+
+        /* the compressed header depends on the link-layer addresses, so
+         * compress it again for the next hop. The next header (if it was
+         * decompressed) goes with the payload, where the NHC encoder
+         * expects it */
+        rest = gnrc_pktbuf_add(NULL, NULL, nh_len + data_len - hdr_len,
+                               GNRC_NETTYPE_UNDEF);
+        if (rest == NULL) {
+            return NULL;
+        }
+        memcpy(rest->data, ((uint8_t *)ipv6->data) + sizeof(ipv6_hdr_t),
+               nh_len);
+        memcpy(((uint8_t *)rest->data) + nh_len, data + hdr_len,
+               data_len - hdr_len);
+        netif_hdr = gnrc_netif_hdr_build(NULL, 0, entry->out_dst,
+                                         entry->out_dst_len);
+        if (netif_hdr == NULL) {
+            gnrc_pktbuf_release(rest);
+            return NULL;
+        }
+        ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = entry->out_netif->pid;
+        netif_hdr->next = gnrc_pktbuf_add(rest, ipv6->data, sizeof(ipv6_hdr_t),
+                                          GNRC_NETTYPE_IPV6);
+        if (netif_hdr->next == NULL) {
+            netif_hdr->next = rest;
+            gnrc_pktbuf_release(netif_hdr);
+            return NULL;
+        }
+        frag = gnrc_pktbuf_add(NULL, pkt->data, sizeof(sixlowpan_frag_t),
+                               GNRC_NETTYPE_SIXLOWPAN);
+        if ((frag == NULL) || !gnrc_sixlowpan_iphc_encode(netif_hdr)) {
+            DEBUG("6lo vrb: unable to compress IPv6 header\n");
+            gnrc_pktbuf_release(netif_hdr);
+            if (frag != NULL) {
+                gnrc_pktbuf_release(frag);
+            }
+            return NULL;
+        }
+        /* _send() builds its own interface header */
+        frag->next = gnrc_pktbuf_remove_snip(netif_hdr, netif_hdr);
+    }
+#else
+    else {
+        (void)data_len;
+        (void)hdr_len;
+        (void)nh_len;
+        return NULL;
+    }
+#endif
+    frag_hdr = frag->data;
+    frag_hdr->tag = byteorder_htons(entry->out_tag);
+    if (gnrc_pkt_len(frag) > entry->out_netif->sixlo.max_frag_size) {
+        DEBUG("6lo vrb: first fragment too big for next hop\n");
+        gnrc_pktbuf_release(frag);
+        return NULL;
+    }
+    return frag;
+}
+
+static bool _forward_1st(gnrc_pktsnip_t *pkt, uint16_t size, uint16_t tag)
+{
+    gnrc_netif_hdr_t *hdr = pkt->next->data;
+    gnrc_pktsnip_t *ipv6, *frag;
+    ipv6_hdr_t *ipv6_hdr;
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_netif_t *netif;
+    vrb_t *entry;
+    size_t hdr_len, nh_len;
+
+    ipv6 = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t),
+                           GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        DEBUG("6lo vrb: unable to allocate IPv6 header\n");
+        return false;
+    }
+    memset(ipv6->data, 0, ipv6->size);
+    if ((hdr_len = _decode(pkt, &ipv6, size, &nh_len)) == 0) {
+        gnrc_pktbuf_release(ipv6);
+        return false;
+    }
+    ipv6_hdr = ipv6->data;
+    /* datagrams for this node are reassembled and those that run out of hops
+     * are handed to IPv6 to report it */
+    if (ipv6_addr_is_multicast(&ipv6_hdr->dst) || (ipv6_hdr->hl <= 1) ||
+        (gnrc_netif_get_by_ipv6_addr(&ipv6_hdr->dst) != NULL) ||
+        (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, NULL, NULL,
+                                           &nce) < 0) ||
+        (nce.l2addr_len > VRB_L2ADDR_MAX_LEN) ||
+        /* NHC expects the complete UDP header in the first fragment */
+        ((ipv6_hdr->nh == PROTNUM_UDP) &&
+         ((nh_len + pkt->size - sizeof(sixlowpan_frag_t) - hdr_len) <
+          sizeof(udp_hdr_t))) ||
+        (hdr->src_l2addr_len > VRB_L2ADDR_MAX_LEN)) {
+        gnrc_pktbuf_release(ipv6);
+        return false;
+    }
+    netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
+    if ((netif == NULL) || !gnrc_netif_is_6ln(netif)) {
+        gnrc_pktbuf_release(ipv6);
+        return false;
+    }
+    if ((entry = _vrb_get_free()) == NULL) {
+        DEBUG("6lo vrb: VRB full, reassemble datagram\n");
+        _stats.full++;
+        gnrc_pktbuf_release(ipv6);
+        return false;
+    }
+    ipv6_hdr->hl--;
+    memcpy(entry->src, gnrc_netif_hdr_get_src_addr(hdr), hdr->src_l2addr_len);
+    memcpy(entry->out_dst, nce.l2addr, nce.l2addr_len);
+    entry->in_pid = hdr->if_pid;
+    entry->src_len = hdr->src_l2addr_len;
+    entry->out_dst_len = nce.l2addr_len;
+    entry->tag = tag;
+    entry->out_tag = gnrc_sixlowpan_frag_next_tag();
+    entry->size = size;
+    entry->forwarded = 0;
+    entry->out_netif = netif;
+    frag = _build_1st(pkt, ipv6, hdr_len, nh_len, entry);
+    gnrc_pktbuf_release(ipv6);
+    if (frag == NULL) {
+        /* fall back to reassembly */
+        entry->out_netif = NULL;
+        return false;
+    }
+    DEBUG("6lo vrb: forward datagram (%u, %u) with tag %u\n",
+          (unsigned)size, tag, entry->out_tag);
+    _stats.datagrams++;
+    /* offsets of subsequent fragments refer to the uncompressed datagram */
+    _send(entry, frag, sizeof(ipv6_hdr_t) + nh_len +
+          (pkt->size - sizeof(sixlowpan_frag_t) - hdr_len));
+    return true;
+}
+
+static void _forward_nth(vrb_t *entry, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *frag;
+
+    if (pkt->size > entry->out_netif->sixlo.max_frag_size) {
+        DEBUG("6lo vrb: fragment too big for next hop, drop datagram\n");
+        entry->out_netif = NULL;
+        return;
+    }
+    frag = gnrc_pktbuf_add(NULL, pkt->data, pkt->size, GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo vrb: unable to allocate fragment\n");
+        return;
+    }
+    ((sixlowpan_frag_n_t *)frag->data)->tag = byteorder_htons(entry->out_tag);
+    _send(entry, frag, pkt->size - sizeof(sixlowpan_frag_n_t));
+}
+
+bool gnrc_sixlowpan_frag_vrb_forward(gnrc_pktsnip_t *pkt, uint16_t offset)
+{
+    gnrc_netif_hdr_t *hdr = pkt->next->data;
+    sixlowpan_frag_t *frag = pkt->data;
+    uint16_t size = byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK;
+    uint16_t tag = byteorder_ntohs(frag->tag);
+    vrb_t *entry;
+
+    if (hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                      GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        return false;
+    }
+    _vrb_gc();
+    entry = _vrb_get(hdr, size, tag);
+    if (offset == 0) {
+        if (entry != NULL) {
+            /* the previous hop restarted the datagram */
+            entry->out_netif = NULL;
+        }
+        return _forward_1st(pkt, size, tag);
+    }
+    if (entry == NULL) {
+        return false;
+    }
+    _forward_nth(entry, pkt);
+    return true;
+}
+
+void gnrc_sixlowpan_frag_vrb_get_stats(gnrc_sixlowpan_frag_vrb_stats_t *stats)
+{
+    *stats = _stats;
+}
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+/** @} */
@@ -38,28 +38,48 @@ static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static gnrc_sixlowpan_msg_frag_t fragment_msg = {KERNEL_PID_UNDEF, NULL, 0, 0};
 #endif
 
+#ifndef MODULE_GNRC_NETAPI_DIRECT
 #if ENABLE_DEBUG
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE];
 #endif
+#ifdef MODULE_GNRC_NETAPI_BATCH
+/* collects the packets passed on from a batch */
+static gnrc_netapi_batch_t _batch;
+#endif
+#endif
 
 
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
 /* handles GNRC_NETAPI_MSG_TYPE_SND commands */
 static void _send(gnrc_pktsnip_t *pkt);
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+/* handles netapi commands in the context of the dispatching thread */
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+
+static gnrc_netreg_entry_cbd_t _cbd = { _netapi_cb, NULL };
+static gnrc_netreg_entry_t _me_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                               &_cbd);
+#else
 /* Main event loop for 6LoWPAN */
 static void *_event_loop(void *args);
+#endif
 
 kernel_pid_t gnrc_sixlowpan_init(void)
 {
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    /* register interest in all 6LoWPAN packets */
+    gnrc_netreg_register(GNRC_NETTYPE_SIXLOWPAN, &_me_reg);
+#else
     if (_pid > KERNEL_PID_UNDEF) {
         return _pid;
     }
 
     _pid = thread_create(_stack, sizeof(_stack), GNRC_SIXLOWPAN_PRIO,
                          THREAD_CREATE_STACKTEST, _event_loop, NULL, "6lo");
+#endif
 
     return _pid;
 }
@@ -291,8 +311,18 @@ static void _send(gnrc_pktsnip_t *pkt)
         /* set the outgoing message's fields */
         msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
         msg.content.ptr = &fragment_msg;
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+        /* there is no 6LoWPAN thread: let the interface's thread send the
+         * fragments */
+        if (msg_try_send(&msg, hdr->if_pid) < 1) {
+            DEBUG("6lo: unable to start fragmentation\n");
+            gnrc_pktbuf_release(pkt2);
+            fragment_msg.pkt = NULL;
+        }
+#else
         /* send message to self */
         msg_send_to_self(&msg);
+#endif
     }
     else {
         DEBUG("6lo: packet too big (%u > %" PRIu16 ")\n",
@@ -307,6 +337,28 @@ static void _send(gnrc_pktsnip_t *pkt)
 #endif
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    gnrc_netapi_direct_acquire();
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_RCV called\n");
+            _receive(pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_SND called\n");
+            _send(pkt);
+            break;
+        default:
+            DEBUG("6lo: operation not supported\n");
+            gnrc_pktbuf_release(pkt);
+            break;
+    }
+    gnrc_netapi_direct_release();
+}
+#else
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
@@ -318,6 +370,9 @@ static void *_event_loop(void *args)
 
     /* register interest in all 6LoWPAN packets */
     gnrc_netreg_register(GNRC_NETTYPE_SIXLOWPAN, &me_reg);
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    gnrc_netapi_batch_enable(sched_active_pid);
+#endif
 
     /* preinitialize ACK */
     reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
@@ -338,6 +393,18 @@ static void *_event_loop(void *args)
                 _send(msg.content.ptr);
                 break;
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_RCV_BATCH received\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _receive, &_batch);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_SND_BATCH received\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _send, &_batch);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("6lo: reply to unsupported get/set\n");
@@ -359,5 +426,6 @@ static void *_event_loop(void *args)
 
     return NULL;
 }
+#endif
 
 /** @} */
@@ -23,6 +23,9 @@
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/sixlowpan/ctx.h"
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+#include "net/gnrc/netif/internal.h"
+#endif
 #include "net/sixlowpan.h"
 #include "utlist.h"
 #include "net/gnrc/nettype.h"
@@ -727,9 +730,20 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
                                    netif_hdr->src_l2addr_len);
             }
             else {
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+                /* take from interface otherwise: we may run on the interface's
+                 * own thread or hold the lock it waits for, so never block on
+                 * it with gnrc_netapi_get() */
+                gnrc_netif_t *netif = gnrc_netif_get_by_pid(netif_hdr->if_pid);
+
+                if (netif != NULL) {
+                    gnrc_netif_ipv6_get_iid(netif, &iid);
+                }
+#else
                 /* but take from driver otherwise */
                 gnrc_netapi_get(netif_hdr->if_pid, NETOPT_IPV6_IID, 0, &iid,
                                 sizeof(eui64_t));
+#endif
             }
 
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
@@ -37,27 +37,52 @@
 #include "debug.h"
 
 static mutex_t _mutex = MUTEX_INIT;
+static gnrc_pktbuf_stats_t _stats;
 
-#ifdef TEST_SUITES
-static unsigned mallocs;
+static inline void _add_used(size_t size)
+{
+    _stats.used += size;
+    if (_stats.used > _stats.used_peak) {
+        _stats.used_peak = _stats.used;
+    }
+}
 
 static inline void *_malloc(size_t size)
 {
-    mallocs++;
-    return malloc(size);
+    void *ptr = malloc(size);
+
+    if (ptr == NULL) {
+        _stats.alloc_fails++;
+    }
+    else {
+        _stats.allocs++;
+        _add_used(size);
+    }
+    return ptr;
+}
+
+static inline void *_realloc(void *ptr, size_t old_size, size_t size)
+{
+    void *new = realloc(ptr, size);
+
+    if (new == NULL) {
+        _stats.alloc_fails++;
+    }
+    else {
+        _stats.used -= old_size;
+        _add_used(size);
+    }
+    return new;
 }
 
-static inline void _free(void *ptr)
+static inline void _free(void *ptr, size_t size)
 {
     if (ptr != NULL) {
-        mallocs--;
+        _stats.frees++;
+        _stats.used -= size;
         free(ptr);
     }
 }
-#else
-#define _malloc(size)   malloc(size)
-#define _free(ptr)      free(ptr)
-#endif
 
 /* internal gnrc_pktbuf functions */
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
@@ -78,9 +103,9 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
 
 void gnrc_pktbuf_init(void)
 {
-#ifdef TEST_SUITES
-    mallocs = 0;
-#endif
+    mutex_lock(&_mutex);
+    memset(&_stats, 0, sizeof(_stats));
+    mutex_unlock(&_mutex);
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
@@ -120,6 +145,7 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
     if (pkt->size == size) {
         _set_pktsnip(header, pkt->next, pkt->data, size, type);
         _set_pktsnip(pkt, header, NULL, 0, pkt->type);
+        _stats.snips[type - GNRC_NETTYPE_IOVEC]++;
         return header;
     }
     /* we can not just "snip off" something from the end of a malloc'd section
@@ -127,20 +153,21 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
     payload = _malloc(pkt->size - size);
     if (payload == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
-        _free(header);
+        _free(header, sizeof(gnrc_pktsnip_t));
         return NULL;
     }
     memcpy(payload, ((uint8_t *)pkt->data) + size, pkt->size - size);
-    header_data = realloc(pkt->data, size);
+    header_data = _realloc(pkt->data, pkt->size, size);
     if (header_data == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
-        _free(payload);
-        _free(header);
+        _free(payload, pkt->size - size);
+        _free(header, sizeof(gnrc_pktsnip_t));
         return NULL;
     }
     pkt->data = payload;
     pkt->size -= size;
     _set_pktsnip(header, pkt->next, header_data, size, type);
+    _stats.snips[type - GNRC_NETTYPE_IOVEC]++;
     pkt->next = header;
     return header;
 }
@@ -168,11 +195,12 @@ static int _realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     /* new size is 0 and data pointer isn't already NULL */
     if ((size == 0) && (pkt->data != NULL)) {
         /* set data pointer to NULL */
-        _free(pkt->data);
+        _free(pkt->data, pkt->size);
         pkt->data = NULL;
     }
     else {
-        void *data = (pkt->data) ? realloc(pkt->data, size) : _malloc(size);
+        void *data = (pkt->data) ? _realloc(pkt->data, pkt->size, size) :
+                                   _malloc(size);
         if (data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
             return ENOMEM;
@@ -210,8 +238,8 @@ static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
         tmp = pkt->next;
         if (pkt->users == 1) {
             pkt->users = 0; /* not necessary but to be on the safe side */
-            _free(pkt->data);
-            _free(pkt);
+            _free(pkt->data, pkt->size);
+            _free(pkt, sizeof(gnrc_pktsnip_t));
         }
         else {
             pkt->users--;
@@ -249,6 +277,13 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
     return pkt;
 }
 
+void gnrc_pktbuf_get_stats(gnrc_pktbuf_stats_t *stats)
+{
+    mutex_lock(&_mutex);
+    memcpy(stats, &_stats, sizeof(_stats));
+    mutex_unlock(&_mutex);
+}
+
 #ifdef DEVELHELP
 void gnrc_pktbuf_stats(void)
 {
@@ -259,8 +294,7 @@ void gnrc_pktbuf_stats(void)
 #ifdef TEST_SUITES
 bool gnrc_pktbuf_is_empty(void)
 {
-    /* assert always true, use valgrind to check */
-    return (mallocs == 0);
+    return (_stats.allocs == _stats.frees);
 }
 
 bool gnrc_pktbuf_is_sane(void)
@@ -284,11 +318,12 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t siz
         _data = _malloc(size);
         if (_data == NULL) {
             DEBUG("pktbuf: error allocating data for new packet snip\n");
-            _free(pkt);
+            _free(pkt, sizeof(gnrc_pktsnip_t));
             return NULL;
         }
     }
     _set_pktsnip(pkt, next, _data, size, type);
+    _stats.snips[type - GNRC_NETTYPE_IOVEC]++;
     if (data != NULL) {
         memcpy(_data, data, size);
     }
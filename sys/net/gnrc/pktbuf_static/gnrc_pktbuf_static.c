@@ -43,6 +43,7 @@ typedef struct _unused {
 static mutex_t _mutex = MUTEX_INIT;
 static uint8_t _pktbuf[GNRC_PKTBUF_SIZE];
 static _unused_t *_first_unused;
+static gnrc_pktbuf_stats_t _stats;
 
 #ifdef DEVELHELP
 /* maximum number of bytes allocated */
@@ -85,6 +86,7 @@ void gnrc_pktbuf_init(void)
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
+    memset(&_stats, 0, sizeof(_stats));
     mutex_unlock(&_mutex);
 }
 
@@ -162,6 +164,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
     }
     pkt->size -= size;
     _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    _stats.snips[type - GNRC_NETTYPE_IOVEC]++;
     pkt->next = marked_snip;
     mutex_unlock(&_mutex);
     return marked_snip;
@@ -206,6 +209,8 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     else if (_align(pkt->size) > aligned_size) {
         _pktbuf_free(((uint8_t *)pkt->data) + aligned_size,
                      pkt->size - aligned_size);
+        /* shrinking in place releases no chunk, only its tail */
+        _stats.frees--;
     }
     pkt->size = size;
     mutex_unlock(&_mutex);
@@ -270,6 +275,19 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
     return pkt;
 }
 
+void gnrc_pktbuf_get_stats(gnrc_pktbuf_stats_t *stats)
+{
+    mutex_lock(&_mutex);
+    memcpy(stats, &_stats, sizeof(_stats));
+    stats->largest_free = 0;
+    for (_unused_t *ptr = _first_unused; ptr != NULL; ptr = ptr->next) {
+        if (ptr->size > stats->largest_free) {
+            stats->largest_free = ptr->size;
+        }
+    }
+    mutex_unlock(&_mutex);
+}
+
 #ifdef DEVELHELP
 #ifdef MODULE_OD
 static inline void _print_chunk(void *chunk, size_t size, int num)
@@ -386,6 +404,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t siz
         }
     }
     _set_pktsnip(pkt, next, _data, size, type);
+    _stats.snips[type - GNRC_NETTYPE_IOVEC]++;
     if (data != NULL) {
         memcpy(_data, data, size);
     }
@@ -403,6 +422,10 @@ static void *_pktbuf_alloc(size_t size)
     }
     if (ptr == NULL) {
         DEBUG("pktbuf: no space left in packet buffer\n");
+        _stats.alloc_fails++;
+        if ((GNRC_PKTBUF_SIZE - _stats.used) >= size) {
+            _stats.alloc_fails_frag++;
+        }
         return NULL;
     }
     /* _unused_t struct would fit => add new space at ptr */
@@ -430,6 +453,11 @@ static void *_pktbuf_alloc(size_t size)
         new->next = ptr->next;
         new->size = ptr->size - size;
     }
+    _stats.allocs++;
+    _stats.used += size;
+    if (_stats.used > _stats.used_peak) {
+        _stats.used_peak = _stats.used;
+    }
 #ifdef DEVELHELP
     uint16_t last_byte = (uint16_t)((((uint8_t *)ptr) + size) - &(_pktbuf[0]));
     if (last_byte > max_byte_count) {
@@ -467,6 +495,8 @@ static void _pktbuf_free(void *data, size_t size)
     }
     new->next = ptr;
     new->size = (size < sizeof(_unused_t)) ? _align(sizeof(_unused_t)) : _align(size);
+    _stats.frees++;
+    _stats.used -= new->size;
     /* calculate number of bytes between new _unused_t chunk and end of packet
      * buffer */
     bytes_at_end = ((&_pktbuf[0] + GNRC_PKTBUF_SIZE) - (((uint8_t *)new) + new->size));
@@ -0,0 +1,746 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Static packet buffer with a two-level segregated fit allocator
+ *
+ * Free chunks are kept in size-segregated doubly linked lists, indexed by a
+ * two-level bitmap (first level: power of two, second level: linear
+ * subdivision). Allocation finds a fitting list with two bit scans and
+ * release coalesces with its neighbours using boundary tags, so both are
+ * independent of the number of chunks in the buffer.
+ *
+ * Since the packet buffer API passes the size of a chunk on release, allocated
+ * chunks carry no header. Instead a bitmap marks the first and last unit of
+ * every free chunk, and free chunks store their size at both ends. Free chunks
+ * too small to hold the list pointers are only tracked by the bitmap and are
+ * merged once one of their neighbours is released.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "bitarithm.h"
+#include "bitfield.h"
+#include "mutex.h"
+#include "od.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if GNRC_PKTBUF_SIZE > UINT16_MAX
+#error "gnrc_pktbuf_tlsf: GNRC_PKTBUF_SIZE must fit into 16 bit"
+#endif
+
+#define _ALIGNMENT_MASK     (sizeof(void *) - 1)
+#define _UNIT               (sizeof(void *))
+#define _UNITS              (GNRC_PKTBUF_SIZE / _UNIT)
+#define _POOL_SIZE          (_UNITS * _UNIT)
+
+/**
+ * @brief   log2 of the number of second level lists per power of two
+ */
+#define _SL_LOG2            (2U)
+#define _SL_NUMOF           (1U << _SL_LOG2)
+
+/* floor(log2(x)) for 16-bit compile-time constants */
+#define _LOG2_2(x)          (((x) & 0x2) ? 1 : 0)
+#define _LOG2_4(x)          (((x) & 0xc) ? (2 + _LOG2_2((x) >> 2)) : _LOG2_2(x))
+#define _LOG2_8(x)          (((x) & 0xf0) ? (4 + _LOG2_4((x) >> 4)) : _LOG2_4(x))
+#define _LOG2_16(x)         (((x) & 0xff00) ? (8 + _LOG2_8((x) >> 8)) : _LOG2_8(x))
+
+#define _FL_NUMOF           ((_LOG2_16(_UNITS) >= _SL_LOG2) ? \
+                             (_LOG2_16(_UNITS) - _SL_LOG2 + 2) : 1)
+
+#define _NIL                (UINT16_MAX)
+
+/**
+ * @brief   Header of a free chunk
+ *
+ * The size is repeated in the last two bytes of the chunk, so a chunk
+ * released directly behind it can find its start. Chunks shorter than
+ * `_MIN_CHUNK` only have the size fields.
+ */
+typedef struct {
+    uint16_t size;      /**< size of the free chunk in byte */
+    uint16_t next;      /**< offset of next free chunk in the same list */
+    uint16_t prev;      /**< offset of previous free chunk in the same list */
+} _free_t;
+
+#define _MIN_CHUNK          ((sizeof(_free_t) + sizeof(uint16_t) + _ALIGNMENT_MASK) & \
+                             ~(_ALIGNMENT_MASK))
+
+static mutex_t _mutex = MUTEX_INIT;
+static uint8_t _pktbuf[GNRC_PKTBUF_SIZE] __attribute__((aligned(sizeof(void *))));
+static uint16_t _lists[_FL_NUMOF][_SL_NUMOF];
+static unsigned _fl_bitmap;
+static uint8_t _sl_bitmap[_FL_NUMOF];
+/* marks first and last unit of every free chunk */
+static BITFIELD(_bounds, _UNITS);
+static gnrc_pktbuf_stats_t _stats;
+
+#ifdef DEVELHELP
+/* maximum number of bytes allocated */
+static uint16_t max_byte_count = 0;
+#endif
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+static void _pktbuf_free(void *data, size_t size);
+
+static inline bool _pktbuf_contains(void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - _pktbuf) < GNRC_PKTBUF_SIZE;
+}
+
+/* fits size to byte alignment */
+static inline size_t _align(size_t size)
+{
+    return (size + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK);
+}
+
+static inline size_t _chunk_size(size_t size)
+{
+    return (size < _MIN_CHUNK) ? _MIN_CHUNK : _align(size);
+}
+
+static inline _free_t *_chunk(uint16_t offset)
+{
+    return (_free_t *)&_pktbuf[offset];
+}
+
+static inline uint16_t *_footer(uint16_t offset, uint16_t size)
+{
+    return (uint16_t *)&_pktbuf[offset + size - sizeof(uint16_t)];
+}
+
+static inline void _mapping(unsigned units, unsigned *fl, unsigned *sl)
+{
+    if (units < _SL_NUMOF) {
+        *fl = 0;
+        *sl = units;
+    }
+    else {
+        unsigned msb = bitarithm_msb(units);
+
+        *fl = msb - _SL_LOG2 + 1;
+        *sl = (units >> (msb - _SL_LOG2)) - _SL_NUMOF;
+    }
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static void _insert(uint16_t offset, uint16_t size)
+{
+    _free_t *chunk = _chunk(offset);
+    unsigned fl, sl;
+
+    chunk->size = size;
+    *_footer(offset, size) = size;
+    bf_set(_bounds, offset / _UNIT);
+    bf_set(_bounds, ((offset + size) / _UNIT) - 1);
+    if (size < _MIN_CHUNK) {
+        /* fragment is too small to be listed */
+        return;
+    }
+    _mapping(size / _UNIT, &fl, &sl);
+    chunk->prev = _NIL;
+    chunk->next = _lists[fl][sl];
+    if (chunk->next != _NIL) {
+        _chunk(chunk->next)->prev = offset;
+    }
+    _lists[fl][sl] = offset;
+    _fl_bitmap |= (1U << fl);
+    _sl_bitmap[fl] |= (1U << sl);
+}
+
+static void _remove(uint16_t offset)
+{
+    _free_t *chunk = _chunk(offset);
+    unsigned fl, sl;
+
+    bf_unset(_bounds, offset / _UNIT);
+    bf_unset(_bounds, ((offset + chunk->size) / _UNIT) - 1);
+    if (chunk->size < _MIN_CHUNK) {
+        return;
+    }
+    _mapping(chunk->size / _UNIT, &fl, &sl);
+    if (chunk->prev == _NIL) {
+        _lists[fl][sl] = chunk->next;
+        if (chunk->next == _NIL) {
+            _sl_bitmap[fl] &= ~(1U << sl);
+            if (_sl_bitmap[fl] == 0) {
+                _fl_bitmap &= ~(1U << fl);
+            }
+        }
+    }
+    else {
+        _chunk(chunk->prev)->next = chunk->next;
+    }
+    if (chunk->next != _NIL) {
+        _chunk(chunk->next)->prev = chunk->prev;
+    }
+}
+
+static uint16_t _find(size_t size)
+{
+    unsigned units = size / _UNIT;
+    unsigned search = units;
+    unsigned fl, sl;
+    uint16_t offset;
+
+    /* round up to the next list boundary, so that every chunk in the list
+     * found is large enough */
+    if (search >= _SL_NUMOF) {
+        search += (1U << (bitarithm_msb(search) - _SL_LOG2)) - 1;
+    }
+    _mapping(search, &fl, &sl);
+    if (fl < _FL_NUMOF) {
+        unsigned sl_map = _sl_bitmap[fl] & (~0U << sl);
+
+        if (sl_map == 0) {
+            unsigned fl_map = _fl_bitmap & (~0U << (fl + 1));
+
+            if (fl_map != 0) {
+                fl = bitarithm_lsb(fl_map);
+                sl_map = _sl_bitmap[fl];
+            }
+        }
+        if (sl_map != 0) {
+            return _lists[fl][bitarithm_lsb(sl_map)];
+        }
+    }
+    /* no list guaranteed to fit, but the head of the list of the requested
+     * size might still be large enough */
+    _mapping(units, &fl, &sl);
+    offset = _lists[fl][sl];
+    if ((offset != _NIL) && (_chunk(offset)->size >= size)) {
+        return offset;
+    }
+    return _NIL;
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    memset(_lists, 0xff, sizeof(_lists));
+    memset(_sl_bitmap, 0, sizeof(_sl_bitmap));
+    memset(_bounds, 0, sizeof(_bounds));
+    _fl_bitmap = 0;
+    _insert(0, _POOL_SIZE);
+    memset(&_stats, 0, sizeof(_stats));
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > GNRC_PKTBUF_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    /* size required for chunk */
+    size_t required_new_size = _chunk_size(size);
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* marked data would not be a chunk of its own => move data around to
+     * allow for proper free */
+    if ((pkt->size != size) &&
+        ((size < required_new_size) || ((pkt->size - size) < _MIN_CHUNK))) {
+        void *new_data_rest;
+        new_data_marked = _pktbuf_alloc(size);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        new_data_rest = _pktbuf_alloc(pkt->size - size);
+        if (new_data_rest == NULL) {
+            DEBUG("pktbuf: could not reallocate remaining section.\n");
+            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _pktbuf_free(new_data_marked, size);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
+        _pktbuf_free(pkt->data, pkt->size);
+        marked_snip->data = new_data_marked;
+        pkt->data = new_data_rest;
+    }
+    else {
+        new_data_marked = pkt->data;
+        /* if (pkt->size - size) != 0 take remainder of data, otherwise set NULL */
+        pkt->data = (pkt->size != size) ? (((uint8_t *)pkt->data) + size) :
+                                          NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    _stats.snips[type - GNRC_NETTYPE_IOVEC]++;
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    size_t aligned_size = _chunk_size(size);
+
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = NULL;
+    }
+    /* if new size is bigger than old size */
+    else if ((size > pkt->size) ||                      /* new size does not fit */
+        ((pkt->size - aligned_size) < _MIN_CHUNK)) {    /* resulting hole would not be listed */
+        void *new_data = _pktbuf_alloc(size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+        }
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = new_data;
+    }
+    else if (_align(pkt->size) > aligned_size) {
+        _pktbuf_free(((uint8_t *)pkt->data) + aligned_size,
+                     pkt->size - aligned_size);
+        /* shrinking in place releases no chunk, only its tail */
+        _stats.frees--;
+    }
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_pktbuf_contains(pkt));
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _pktbuf_free(pkt->data, pkt->size);
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+void gnrc_pktbuf_get_stats(gnrc_pktbuf_stats_t *stats)
+{
+    mutex_lock(&_mutex);
+    memcpy(stats, &_stats, sizeof(_stats));
+    stats->largest_free = 0;
+    if (_fl_bitmap != 0) {
+        /* the largest chunk is in the highest non-empty list */
+        unsigned fl = bitarithm_msb(_fl_bitmap);
+        unsigned sl = bitarithm_msb(_sl_bitmap[fl]);
+
+        for (uint16_t offset = _lists[fl][sl]; offset != _NIL;
+             offset = _chunk(offset)->next) {
+            if (_chunk(offset)->size > stats->largest_free) {
+                stats->largest_free = _chunk(offset)->size;
+            }
+        }
+    }
+    mutex_unlock(&_mutex);
+}
+
+#ifdef DEVELHELP
+#ifdef MODULE_OD
+static inline void _print_chunk(void *chunk, size_t size, int num)
+{
+    printf("=========== chunk %3d (%-10p size: %4u) ===========\n", num, chunk,
+           (unsigned int)size);
+    od_hex_dump(chunk, size, OD_WIDTH_DEFAULT);
+}
+
+static inline void _print_unused(uint16_t offset)
+{
+    _free_t *ptr = _chunk(offset);
+
+    if (ptr->size < _MIN_CHUNK) {
+        printf("~ unused: %p (unlisted, size: %4u) ~\n", (void *)ptr,
+               ptr->size);
+    }
+    else {
+        unsigned fl, sl;
+
+        _mapping(ptr->size / _UNIT, &fl, &sl);
+        printf("~ unused: %p (list: %u/%u, size: %4u) ~\n", (void *)ptr, fl, sl,
+               ptr->size);
+    }
+}
+#endif
+
+void gnrc_pktbuf_stats(void)
+{
+#ifdef MODULE_OD
+    unsigned used = 0;
+    int count = 0;
+
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&_pktbuf[0], (void *)&_pktbuf[GNRC_PKTBUF_SIZE], GNRC_PKTBUF_SIZE);
+    printf("  position of last byte used: %" PRIu16 "\n", max_byte_count);
+    /* walk the buffer in address order using the boundary tags */
+    for (unsigned unit = 0; unit < _UNITS; unit++) {
+        if (bf_isset(_bounds, unit)) {
+            uint16_t offset = unit * _UNIT;
+
+            if (used < unit) {
+                _print_chunk(&_pktbuf[used * _UNIT], (unit - used) * _UNIT,
+                             count++);
+            }
+            _print_unused(offset);
+            unit += (_chunk(offset)->size / _UNIT) - 1;
+            used = unit + 1;
+        }
+    }
+    if (used < _UNITS) {
+        _print_chunk(&_pktbuf[used * _UNIT], (_UNITS - used) * _UNIT, count);
+    }
+#else
+    DEBUG("pktbuf: needs od module\n");
+#endif
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    return bf_isset(_bounds, 0) && (_chunk(0)->size == _POOL_SIZE);
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    unsigned listed = 0, walked = 0;
+
+    /* Invariants of this implementation:
+     *  - a list is non-empty iff its bits in the first and second level
+     *    bitmaps are set
+     *  - forall chunks in list (fl, sl): chunk is aligned, at least
+     *    _MIN_CHUNK long, lies within the buffer and maps to (fl, sl)
+     *  - forall chunks in lists: both boundary tags are set
+     *  - forall free chunks (listed or not): the footer repeats the size
+     *  - free chunks never touch each other (they would have been merged)
+     */
+    for (unsigned fl = 0; fl < _FL_NUMOF; fl++) {
+        if (((_fl_bitmap & (1U << fl)) != 0) != (_sl_bitmap[fl] != 0)) {
+            return false;
+        }
+        for (unsigned sl = 0; sl < _SL_NUMOF; sl++) {
+            uint16_t prev = _NIL;
+
+            if (((_sl_bitmap[fl] & (1U << sl)) != 0) != (_lists[fl][sl] != _NIL)) {
+                return false;
+            }
+            for (uint16_t offset = _lists[fl][sl]; offset != _NIL;
+                 offset = _chunk(offset)->next) {
+                _free_t *ptr;
+                unsigned ptr_fl, ptr_sl;
+
+                if ((offset >= _POOL_SIZE) || (offset & _ALIGNMENT_MASK) ||
+                    (++listed > _UNITS)) {
+                    return false;
+                }
+                ptr = _chunk(offset);
+                if ((ptr->prev != prev) || (ptr->size < _MIN_CHUNK) ||
+                    (ptr->size & _ALIGNMENT_MASK) ||
+                    ((offset + ptr->size) > _POOL_SIZE)) {
+                    return false;
+                }
+                _mapping(ptr->size / _UNIT, &ptr_fl, &ptr_sl);
+                if ((ptr_fl != fl) || (ptr_sl != sl) ||
+                    !bf_isset(_bounds, offset / _UNIT) ||
+                    !bf_isset(_bounds, ((offset + ptr->size) / _UNIT) - 1)) {
+                    return false;
+                }
+                prev = offset;
+            }
+        }
+    }
+    for (unsigned unit = 0; unit < _UNITS; unit++) {
+        if (bf_isset(_bounds, unit)) {
+            uint16_t size = _chunk(unit * _UNIT)->size;
+            unsigned end = unit + (size / _UNIT);
+
+            if ((end <= unit) || (end > _UNITS) ||
+                (*_footer(unit * _UNIT, size) != size) ||
+                ((end < _UNITS) && bf_isset(_bounds, end))) {
+                return false;
+            }
+            if (size >= _MIN_CHUNK) {
+                walked++;
+            }
+            unit = end - 1;
+        }
+    }
+
+    return listed == walked;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            return NULL;
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    _stats.snips[type - GNRC_NETTYPE_IOVEC]++;
+    if (data != NULL) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    uint16_t offset, chunk_size;
+
+    size = _chunk_size(size);
+    if (size > _POOL_SIZE) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+        _stats.alloc_fails++;
+        return NULL;
+    }
+    offset = _find(size);
+    if (offset == _NIL) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+        _stats.alloc_fails++;
+        if ((_POOL_SIZE - _stats.used) >= size) {
+            _stats.alloc_fails_frag++;
+        }
+        return NULL;
+    }
+    chunk_size = _chunk(offset)->size;
+    _remove(offset);
+    if (chunk_size > size) {
+        _insert(offset + size, chunk_size - size);
+    }
+    _stats.allocs++;
+    _stats.used += size;
+    if (_stats.used > _stats.used_peak) {
+        _stats.used_peak = _stats.used;
+    }
+#ifdef DEVELHELP
+    uint16_t last_byte = (uint16_t)(offset + size);
+    if (last_byte > max_byte_count) {
+        max_byte_count = last_byte;
+    }
+#endif
+    return &_pktbuf[offset];
+}
+
+static void _pktbuf_free(void *data, size_t size)
+{
+    unsigned start, end;
+
+    if (!_pktbuf_contains(data)) {
+        return;
+    }
+    start = ((uint8_t *)data - _pktbuf) / _UNIT;
+    end = start + (_chunk_size(size) / _UNIT);
+    _stats.frees++;
+    _stats.used -= _chunk_size(size);
+    /* merge with free chunk in front */
+    if ((start > 0) && bf_isset(_bounds, start - 1)) {
+        uint16_t prev_size = *_footer(0, start * _UNIT);
+
+        start -= prev_size / _UNIT;
+        _remove(start * _UNIT);
+    }
+    /* merge with free chunk behind */
+    if ((end < _UNITS) && bf_isset(_bounds, end)) {
+        uint16_t next = end * _UNIT;
+
+        end += _chunk(next)->size / _UNIT;
+        _remove(next);
+    }
+    _insert(start * _UNIT, (end - start) * _UNIT);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+
+    if (new == NULL) {
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/** @} */
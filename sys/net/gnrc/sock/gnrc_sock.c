@@ -114,6 +114,30 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
     return 0;
 }
 
+gnrc_pktsnip_t *gnrc_sock_payload_build(const struct iovec *vector,
+                                        unsigned count)
+{
+    gnrc_pktsnip_t *payload;
+    uint8_t *ptr;
+    size_t len = 0;
+
+    for (unsigned i = 0; i < count; i++) {
+        len += vector[i].iov_len;
+    }
+    payload = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    ptr = payload->data;
+    for (unsigned i = 0; i < count; i++) {
+        if (vector[i].iov_len > 0) {
+            memcpy(ptr, vector[i].iov_base, vector[i].iov_len);
+            ptr += vector[i].iov_len;
+        }
+    }
+    return payload;
+}
+
 ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
                        const sock_ip_ep_t *remote, uint8_t nh)
 {
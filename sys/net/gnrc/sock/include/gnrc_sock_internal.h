@@ -24,6 +24,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <sys/uio.h>
 #include "mbox.h"
 #include "net/af.h"
 #include "net/gnrc.h"
@@ -109,6 +110,13 @@ void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_
 ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt, uint32_t timeout,
                        sock_ip_ep_t *remote);
 
+/**
+ * @brief   Copy the buffers in @p vector into a single payload snip
+ * @internal
+ */
+gnrc_pktsnip_t *gnrc_sock_payload_build(const struct iovec *vector,
+                                        unsigned count);
+
 /**
  * @brief   Send a packet internally
  * @internal
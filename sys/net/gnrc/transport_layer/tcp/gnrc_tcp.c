@@ -208,6 +208,92 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const uint8_t *target_addr, uint1
     return ret;
 }
 
+/**
+ * @brief Puts a TCB into LISTEN state without waiting for a connection.
+ *
+ * @param[in,out] tcb          TCB holding the connection information.
+ * @param[in]     queue        Listen queue @p tcb belongs to.
+ * @param[in]     local_addr   Local address to bind on, NULL for any address.
+ * @param[in]     local_port   Local port to bind on.
+ *
+ * @returns   Zero on success.
+ *            -EISCONN if TCB is already in use.
+ */
+static int _listen(gnrc_tcp_tcb_t *tcb, gnrc_tcp_tcb_queue_t *queue, const uint8_t *local_addr,
+                   const uint16_t local_port)
+{
+    if (tcb->state != FSM_STATE_CLOSED) {
+        return -EISCONN;
+    }
+
+    /* Mark connection as passive opend */
+    tcb->status |= STATUS_PASSIVE;
+    if (local_addr == NULL) {
+        tcb->status |= STATUS_ALLOW_ANY_ADDR;
+    }
+#ifdef MODULE_GNRC_IPV6
+    /* If local address is specified: Copy it into TCB */
+    else if (tcb->address_family == AF_INET6) {
+        memcpy(tcb->local_addr, local_addr, sizeof(ipv6_addr_t));
+    }
+#endif
+    tcb->local_port = local_port;
+    tcb->queue = queue;
+    return _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+}
+
+/**
+ * @brief Resets a closed TCB of a listen queue and lets it listen again.
+ *
+ * @note Only called by gnrc_tcp_accept() with the queue's lock held.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _relisten(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_tcp_tcb_queue_t *queue = tcb->queue;
+    uint16_t local_port = tcb->local_port;
+    uint16_t rcv_buf_size = tcb->rcv_buf_size;
+    uint8_t any_addr = tcb->status & STATUS_ALLOW_ANY_ADDR;
+#ifdef MODULE_GNRC_IPV6
+    uint8_t local_addr[sizeof(ipv6_addr_t)];
+
+    memcpy(local_addr, tcb->local_addr, sizeof(local_addr));
+#endif
+
+    gnrc_tcp_tcb_init(tcb);
+    tcb->rcv_buf_size = rcv_buf_size;
+#ifdef MODULE_GNRC_IPV6
+    _listen(tcb, queue, (any_addr) ? NULL : local_addr, local_port);
+#else
+    (void) any_addr;
+    _listen(tcb, queue, NULL, local_port);
+#endif
+}
+
+/**
+ * @brief Hands a closed, accepted TCB back to its listen queue.
+ *
+ * The TCB listens again with the next call to gnrc_tcp_accept() on the
+ * queue. A thread blocked in gnrc_tcp_accept() is woken up for it.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _release(gnrc_tcp_tcb_t *tcb)
+{
+    /* The queue is only valid with fsm_lock held, gnrc_tcp_stop_listen()
+     * detaches it under this lock */
+    mutex_lock(&(tcb->fsm_lock));
+    if (tcb->queue != NULL) {
+        msg_t msg;
+
+        tcb->status &= ~STATUS_ACCEPTED;
+        msg.type = MSG_TYPE_NOTIFY_USER;
+        mbox_try_put(&(tcb->queue->mbox), &msg);
+    }
+    mutex_unlock(&(tcb->fsm_lock));
+}
+
 /* External GNRC TCP API */
 int gnrc_tcp_init(void)
 {
@@ -240,11 +326,26 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     tcb->rtt_var = RTO_UNINITIALIZED;
     tcb->srtt = RTO_UNINITIALIZED;
     tcb->rto = RTO_UNINITIALIZED;
+    tcb->rcv_buf_size = GNRC_TCP_RCV_BUF_SIZE;
     mbox_init(&(tcb->mbox), tcb->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
     mutex_init(&(tcb->fsm_lock));
     mutex_init(&(tcb->function_lock));
 }
 
+void gnrc_tcp_tcb_set_rcv_buf_size(gnrc_tcp_tcb_t *tcb, const size_t size)
+{
+    assert(tcb != NULL);
+    assert(size > 0);
+
+    /* No window scaling: The window has to fit into 16 bit */
+    if (size == 0) {
+        tcb->rcv_buf_size = GNRC_TCP_RCV_BUF_BLOCK_SIZE;
+    }
+    else {
+        tcb->rcv_buf_size = (size < UINT16_MAX) ? size : UINT16_MAX;
+    }
+}
+
 int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
                          const uint8_t *target_addr, const uint16_t target_port,
                          const uint16_t local_port)
@@ -294,6 +395,167 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
     return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
 }
 
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, const size_t tcbs_len,
+                    const uint8_t address_family, const uint8_t *local_addr,
+                    const uint16_t local_port)
+{
+    assert(queue != NULL);
+    assert(tcbs != NULL);
+    assert(local_port != PORT_UNSPEC);
+
+    int ret = 0;
+
+    /* Check AF-Family support if local address was supplied */
+    if (local_addr != NULL) {
+#ifdef MODULE_GNRC_IPV6
+        if (address_family != AF_INET6) {
+            return -EAFNOSUPPORT;
+        }
+#else
+        return -EAFNOSUPPORT;
+#endif
+    }
+
+    mutex_init(&(queue->lock));
+    mbox_init(&(queue->mbox), queue->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+    queue->tcbs = tcbs;
+    queue->tcbs_len = tcbs_len;
+
+    for (size_t i = 0; i < tcbs_len; i++) {
+        /* Check if AF-Family matches internally used AF-Family */
+        if (local_addr != NULL && tcbs[i].address_family != address_family) {
+            ret = -EINVAL;
+        }
+        else {
+            mutex_lock(&(tcbs[i].function_lock));
+            ret = _listen(&tcbs[i], queue, local_addr, local_port);
+            mutex_unlock(&(tcbs[i].function_lock));
+        }
+        if (ret < 0) {
+            /* Undo the TCBs set up so far */
+            queue->tcbs_len = i;
+            gnrc_tcp_stop_listen(queue);
+            return ret;
+        }
+    }
+    return 0;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t timeout_duration_us)
+{
+    assert(queue != NULL);
+    assert(tcb != NULL);
+
+    msg_t msg;
+    xtimer_t user_timeout;
+    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(queue->mbox)};
+    int ret = 0;
+
+    /* Lock the queue for this function call */
+    mutex_lock(&(queue->lock));
+    if (queue->tcbs == NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EINVAL;
+    }
+
+    /* 'Flush' mbox */
+    while (mbox_try_get(&(queue->mbox), &msg) != 0) {
+    }
+
+    /* Setup user specified timeout if timeout_us is greater than zero */
+    if (timeout_duration_us > 0) {
+        _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
+    }
+
+    *tcb = NULL;
+    while (ret == 0) {
+        for (size_t i = 0; i < queue->tcbs_len && *tcb == NULL; i++) {
+            gnrc_tcp_tcb_t *iter = &(queue->tcbs[i]);
+
+            bool closed = false;
+
+            /* Take the first established connection, that was not accepted yet */
+            mutex_lock(&(iter->fsm_lock));
+            if (!(iter->status & STATUS_ACCEPTED)) {
+                if (iter->state == FSM_STATE_ESTABLISHED ||
+                    iter->state == FSM_STATE_CLOSE_WAIT) {
+                    iter->status |= STATUS_ACCEPTED;
+                    *tcb = iter;
+                }
+                else if (iter->state == FSM_STATE_CLOSED) {
+                    closed = true;
+                }
+            }
+            mutex_unlock(&(iter->fsm_lock));
+
+            /* Connection was closed before it was accepted or was handed back
+             * after it was closed: Listen again. A closed TCB is not known to
+             * the TCP thread and no user holds it, so the queue's lock is
+             * enough to reset it. */
+            if (closed) {
+                _relisten(iter);
+            }
+        }
+        if (*tcb != NULL) {
+            break;
+        }
+
+        /* If this call is non-blocking: Return */
+        if (timeout_duration_us == 0) {
+            ret = -EAGAIN;
+            break;
+        }
+
+        /* Wait for connection changes */
+        mbox_get(&(queue->mbox), &msg);
+        switch (msg.type) {
+            case MSG_TYPE_USER_SPEC_TIMEOUT:
+                DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+                ret = -ETIMEDOUT;
+                break;
+
+            case MSG_TYPE_NOTIFY_USER:
+                DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : NOTIFY_USER\n");
+                break;
+
+            default:
+                DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : other message type\n");
+        }
+    }
+
+    /* Cleanup */
+    if (timeout_duration_us > 0) {
+        xtimer_remove(&user_timeout);
+    }
+    mutex_unlock(&(queue->lock));
+    return ret;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    mutex_lock(&(queue->lock));
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *iter = &(queue->tcbs[i]);
+        bool accepted;
+
+        /* Detach TCB, so it does not listen again */
+        mutex_lock(&(iter->fsm_lock));
+        iter->queue = NULL;
+        accepted = (iter->status & STATUS_ACCEPTED);
+        mutex_unlock(&(iter->fsm_lock));
+
+        if (!accepted) {
+            gnrc_tcp_abort(iter);
+        }
+    }
+    queue->tcbs = NULL;
+    queue->tcbs_len = 0;
+    mutex_unlock(&(queue->lock));
+}
+
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
@@ -336,8 +598,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent. Sent data is kept for retransmission, don't wait for an ACK */
+    while (ret == 0) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -356,9 +618,12 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                            &probe_timeout_arg);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
+        /* Try to send data in case we are not probing */
+        if (!probing_mode) {
             ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+            if (ret != 0) {
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -372,7 +637,7 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
+                /* Previously sent data stays queued, it is part of the stream already */
                 ret = -ETIMEDOUT;
                 break;
 
@@ -488,8 +753,7 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
                     break;
 
                 case MSG_TYPE_USER_SPEC_TIMEOUT:
-                    DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                    _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
+                    DEBUG("gnrc_tcp.c : gnrc_tcp_recv() : USER_SPEC_TIMEOUT\n");
                     ret = -ETIMEDOUT;
                     break;
 
@@ -525,6 +789,9 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
         mutex_unlock(&(tcb->function_lock));
+
+        /* Accepted connection of a listen queue: Hand it back */
+        _release(tcb);
         return;
     }
 
@@ -564,6 +831,9 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     xtimer_remove(&connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
+
+    /* Accepted connection of a listen queue: Hand it back */
+    _release(tcb);
 }
 
 void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
@@ -577,6 +847,9 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
     mutex_unlock(&(tcb->function_lock));
+
+    /* Accepted connection of a listen queue: Hand it back */
+    _release(tcb);
 }
 
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
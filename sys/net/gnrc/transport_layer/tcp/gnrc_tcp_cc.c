@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h
+ * @}
+ */
+#include "internal/common.h"
+#include "internal/cc.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Upper bound of the congestion window: the largest window a peer
+ *        can advertise without window scaling.
+ */
+#define CWND_MAX (UINT16_MAX)
+
+/**
+ * @brief Returns the sender maximum segment size (SMSS).
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   SMSS of the connection.
+ */
+static inline uint32_t _smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->mss < GNRC_TCP_MSS) ? tcb->mss : GNRC_TCP_MSS;
+}
+
+/**
+ * @brief Returns the number of bytes in flight.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Sent, but unacknowledged bytes.
+ */
+static inline uint32_t _flight_size(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->snd_nxt - tcb->snd_una;
+}
+
+/**
+ * @brief Grows the congestion window by slow start or congestion avoidance.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+static void _grow(gnrc_tcp_tcb_t *tcb, const uint32_t acked)
+{
+    uint32_t smss = _smss(tcb);
+
+    if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    else if (tcb->cwnd > 0) {
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+    if (tcb->cwnd > CWND_MAX) {
+        tcb->cwnd = CWND_MAX;
+    }
+}
+
+/**
+ * @brief Halves the slow start threshold and starts loss recovery.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _enter_recovery(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t half = _flight_size(tcb) / 2;
+    uint32_t min = 2 * _smss(tcb);
+
+    tcb->ssthresh = (half > min) ? half : min;
+    tcb->recover = tcb->snd_nxt;
+    tcb->status |= STATUS_RECOVERY;
+}
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    tcb->cwnd = GNRC_TCP_CWND_INITIAL * _smss(tcb);
+    tcb->ssthresh = UINT32_MAX;
+    tcb->recover = tcb->snd_nxt;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_RECOVERY;
+}
+
+uint32_t _cc_usable_window(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t wnd = (tcb->snd_wnd < tcb->cwnd) ? tcb->snd_wnd : tcb->cwnd;
+    uint32_t flight = _flight_size(tcb);
+
+    return (flight < wnd) ? (wnd - flight) : 0;
+}
+
+bool _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked)
+{
+    uint32_t smss = _smss(tcb);
+
+    if (tcb->status & STATUS_RECOVERY) {
+        bool fast = (tcb->dup_acks >= GNRC_TCP_DUP_ACK_THRESHOLD);
+
+        /* Partial ACK: the next segment was lost as well */
+        if (LSS_32_BIT(tcb->snd_una, tcb->recover)) {
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : partial ACK\n");
+            if (fast) {
+                /* Deflate by the amount acknowledged, add back one SMSS */
+                tcb->cwnd = (tcb->cwnd > acked) ? (tcb->cwnd - acked) : 0;
+                if (acked >= smss) {
+                    tcb->cwnd += smss;
+                }
+                if (tcb->cwnd < smss) {
+                    tcb->cwnd = smss;
+                }
+            }
+            else {
+                _grow(tcb, acked);
+            }
+            return true;
+        }
+
+        /* Full ACK: everything outstanding when recovery started was received */
+        DEBUG("gnrc_tcp_cc.c : _cc_ack() : recovery finished\n");
+        tcb->status &= ~STATUS_RECOVERY;
+        tcb->dup_acks = 0;
+        if (fast) {
+            uint32_t flight = _flight_size(tcb);
+
+            flight = ((flight > smss) ? flight : smss) + smss;
+            tcb->cwnd = (tcb->ssthresh < flight) ? tcb->ssthresh : flight;
+            return false;
+        }
+    }
+    tcb->dup_acks = 0;
+    _grow(tcb, acked);
+    return false;
+}
+
+bool _cc_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->status & STATUS_RECOVERY) {
+        /* In fast recovery every duplicate ACK means a segment left the network */
+        if (tcb->dup_acks >= GNRC_TCP_DUP_ACK_THRESHOLD && tcb->cwnd < CWND_MAX) {
+            tcb->cwnd += _smss(tcb);
+        }
+        return false;
+    }
+    if (++tcb->dup_acks < GNRC_TCP_DUP_ACK_THRESHOLD) {
+        return false;
+    }
+    DEBUG("gnrc_tcp_cc.c : _cc_dup_ack() : fast retransmit\n");
+    _enter_recovery(tcb);
+    tcb->cwnd = tcb->ssthresh + (GNRC_TCP_DUP_ACK_THRESHOLD * _smss(tcb));
+    return true;
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    DEBUG("gnrc_tcp_cc.c : _cc_timeout()\n");
+    /* Only the first retransmission of a segment halves the threshold */
+    if (tcb->retries == 0) {
+        _enter_recovery(tcb);
+    }
+    else {
+        tcb->recover = tcb->snd_nxt;
+        tcb->status |= STATUS_RECOVERY;
+    }
+    tcb->dup_acks = 0;
+    tcb->cwnd = _smss(tcb);
+}
@@ -16,6 +16,7 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
@@ -26,6 +27,14 @@
  */
 rcvbuf_t _static_buf;
 
+/**
+ * @brief Number of blocks needed for @p size bytes.
+ */
+static inline size_t _blocks(const size_t size)
+{
+    return (size + GNRC_TCP_RCV_BUF_BLOCK_SIZE - 1) / GNRC_TCP_RCV_BUF_BLOCK_SIZE;
+}
+
 /**
  * @brief Initializes all receive buffers.
  */
@@ -33,46 +42,76 @@ void _rcvbuf_init(void)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
     mutex_init(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
-    }
+    memset(_static_buf.used, 0, sizeof(_static_buf.used));
 }
 
 /**
  * @brief Allocate receive buffer.
  *
+ * Takes the first free run of blocks covering @p size. If there is none, the
+ * longest free run is taken.
+ *
+ * @param[in,out] size   Requested size, set to the allocated size.
+ *
  * @returns   Not NULL if a receive buffer was allocated.
  *            NULL if allocation failed.
  */
-static void* _rcvbuf_alloc(void)
+static void* _rcvbuf_alloc(size_t *size)
 {
-    void *result = NULL;
+    size_t want = _blocks(*size);
+    size_t best = 0;
+    size_t best_len = 0;
+    size_t start = 0;
+
+    /* A zero sized buffer would take the longest free run and never free it */
+    assert(want > 0);
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
-            break;
+    for (size_t i = 0; i <= RCVBUF_BLOCKS; i++) {
+        if (i < RCVBUF_BLOCKS && !bf_isset(_static_buf.used, i)) {
+            if (i - start + 1 == want) {
+                best = start;
+                best_len = want;
+                break;
+            }
+            continue;
+        }
+        /* End of a free run */
+        if (i - start > best_len) {
+            best = start;
+            best_len = i - start;
         }
+        start = i + 1;
+    }
+    for (size_t i = best; i < best + best_len; i++) {
+        bf_set(_static_buf.used, i);
     }
     mutex_unlock(&(_static_buf.lock));
-    return result;
+
+    if (best_len == 0) {
+        return NULL;
+    }
+    if (best_len < want) {
+        *size = best_len * GNRC_TCP_RCV_BUF_BLOCK_SIZE;
+    }
+    return &(_static_buf.pool[best * GNRC_TCP_RCV_BUF_BLOCK_SIZE]);
 }
 
 /**
  * @brief Release allocated receive buffer.
  *
- * @param[in] buf   Pointer to buffer that should be released.
+ * @param[in] buf    Pointer to buffer that should be released.
+ * @param[in] size   Size of @p buf.
  */
-static void _rcvbuf_free(void * const buf)
+static void _rcvbuf_free(void * const buf, const size_t size)
 {
+    size_t first = ((uint8_t *) buf - _static_buf.pool) / GNRC_TCP_RCV_BUF_BLOCK_SIZE;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
-        }
+    for (size_t i = first; i < first + _blocks(size); i++) {
+        bf_unset(_static_buf.used, i);
     }
     mutex_unlock(&(_static_buf.lock));
 }
@@ -80,13 +119,18 @@ static void _rcvbuf_free(void * const buf)
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
+        size_t size = tcb->rcv_buf_size;
+
+        /* No window scaling: The window has to fit into 16 bit */
+        size = (size < UINT16_MAX) ? size : UINT16_MAX;
+        tcb->rcv_buf_raw = _rcvbuf_alloc(&size);
         if (tcb->rcv_buf_raw == NULL) {
             DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
             return -ENOMEM;
         }
         else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, size);
+            tcb->rcv_wnd = size;
         }
     }
     return 0;
@@ -95,7 +139,7 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
+        _rcvbuf_free(tcb->rcv_buf_raw, tcb->rcv_buf.size);
         tcb->rcv_buf_raw = NULL;
     }
 }
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       TCP congestion control (NewReno) declarations.
+ *
+ * @see [RFC 5681](https://tools.ietf.org/html/rfc5681)
+ * @see [RFC 6582](https://tools.ietf.org/html/rfc6582)
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes congestion control state of a connection.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Number of bytes that may be sent without exceeding the send
+ *        and congestion windows.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Usable window in bytes.
+ */
+uint32_t _cc_usable_window(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Updates congestion control state for an ACK of new data.
+ *
+ * @pre @p tcb->snd_una was already advanced to the acknowledgement number.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ *
+ * @returns   true, if the oldest unacknowledged segment has to be
+ *            retransmitted (partial ACK during loss recovery).
+ *            false otherwise.
+ */
+bool _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked);
+
+/**
+ * @brief Updates congestion control state for a duplicate ACK.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   true, if the oldest unacknowledged segment has to be
+ *            retransmitted (fast retransmit).
+ *            false otherwise.
+ */
+bool _cc_dup_ack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Updates congestion control state for a retransmission timeout.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
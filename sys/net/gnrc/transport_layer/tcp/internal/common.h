@@ -49,6 +49,9 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_RECOVERY       (1 << 4)
+#define STATUS_RTT_MEASURE    (1 << 5)
+#define STATUS_ACCEPTED       (1 << 6)
 /** @} */
 
 /**
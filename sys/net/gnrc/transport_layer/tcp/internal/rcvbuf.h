@@ -23,6 +23,7 @@
 #define RCVBUF_H
 
 #include <stdint.h>
+#include "bitfield.h"
 #include "mutex.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
@@ -32,19 +33,18 @@ extern "C" {
 #endif
 
 /**
- * @brief Receive buffer entry.
+ * @brief Number of blocks in the receive buffer pool.
  */
-typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} rcvbuf_entry_t;
+#define RCVBUF_BLOCKS ((GNRC_TCP_RCV_BUF_POOL_SIZE + GNRC_TCP_RCV_BUF_BLOCK_SIZE - 1) / \
+                       GNRC_TCP_RCV_BUF_BLOCK_SIZE)
 
 /**
- * @brief   Stuct holding receive buffers.
+ * @brief   Stuct holding the receive buffer pool.
  */
 typedef struct rcvbuf {
-    mutex_t lock;                                 /**< Lock for allocation synchronization */
-    rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
+    mutex_t lock;                    /**< Lock for pool access synchronization */
+    BITFIELD(used, RCVBUF_BLOCKS);   /**< Allocated blocks */
+    uint8_t pool[RCVBUF_BLOCKS * GNRC_TCP_RCV_BUF_BLOCK_SIZE]; /**< Receive buffer storage */
 } rcvbuf_t;
 
 /**
@@ -55,10 +55,14 @@ void _rcvbuf_init(void);
 /**
  * @brief Allocate receive buffer and assign it to TCB.
  *
+ * A buffer of @p tcb->rcv_buf_size bytes, rounded up to full blocks, is taken
+ * from the pool. If there is not enough contiguous space, the largest free
+ * area is taken instead. The receive window is set to the buffer size.
+ *
  * @param[in,out] tcb   TCB that aquires receive buffer.
  *
  * @returns   Zero  on success.
- *            -ENOMEM if all receive buffers are currently used.
+ *            -ENOMEM if the pool is exhausted.
  */
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 
@@ -38,6 +38,16 @@
  */
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+
+/**
+ * @brief   Callback registration of UDP in direct call mode
+ */
+static gnrc_netreg_entry_cbd_t _cbd = { _netapi_cb, NULL };
+static gnrc_netreg_entry_t _netreg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                               &_cbd);
+#else
 /**
  * @brief   Allocate memory for the UDP thread's stack
  */
@@ -46,6 +56,13 @@ static char _stack[GNRC_UDP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_UDP_STACK_SIZE];
 #endif
+#ifdef MODULE_GNRC_NETAPI_BATCH
+/**
+ * @brief   Collector for the packets the UDP thread passes on from a batch
+ */
+static gnrc_netapi_batch_t _batch;
+#endif
+#endif
 
 /**
  * @brief   Calculate the UDP checksum dependent on the network protocol
@@ -217,6 +234,28 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    gnrc_netapi_direct_acquire();
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
+            _receive(pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
+            _send(pkt);
+            break;
+        default:
+            DEBUG("udp: received unidentified command\n");
+            gnrc_pktbuf_release(pkt);
+            break;
+    }
+    gnrc_netapi_direct_release();
+}
+#else
 static void *_event_loop(void *arg)
 {
     (void)arg;
@@ -231,6 +270,9 @@ static void *_event_loop(void *arg)
     msg_init_queue(msg_queue, GNRC_UDP_MSG_QUEUE_SIZE);
     /* register UPD at netreg */
     gnrc_netreg_register(GNRC_NETTYPE_UDP, &netreg);
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    gnrc_netapi_batch_enable(sched_active_pid);
+#endif
 
     /* dispatch NETAPI messages */
     while (1) {
@@ -244,6 +286,16 @@ static void *_event_loop(void *arg)
                 DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
                 _send(msg.content.ptr);
                 break;
+#ifdef MODULE_GNRC_NETAPI_BATCH
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV_BATCH\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _receive, &_batch);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND_BATCH\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _send, &_batch);
+                break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_SET:
             case GNRC_NETAPI_MSG_TYPE_GET:
                 msg_reply(&msg, &reply);
@@ -257,6 +309,7 @@ static void *_event_loop(void *arg)
     /* never reached */
     return NULL;
 }
+#endif
 
 int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
 {
@@ -298,11 +351,16 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
 
 int gnrc_udp_init(void)
 {
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    /* register UDP at netreg */
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &_netreg);
+#else
     /* check if thread is already running */
     if (_pid == KERNEL_PID_UNDEF) {
         /* start UDP thread */
         _pid = thread_create(_stack, sizeof(_stack), GNRC_UDP_PRIO,
                              THREAD_CREATE_STACKTEST, _event_loop, NULL, "udp");
     }
+#endif
     return _pid;
 }
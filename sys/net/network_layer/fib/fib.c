@@ -24,6 +24,7 @@
 #include <string.h>
 #include <inttypes.h>
 #include <errno.h>
+#include <assert.h>
 #include "thread.h"
 #include "mutex.h"
 #include "msg.h"
@@ -65,6 +66,407 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+/**
+ * @brief returns the FIB entry of a trie node
+ *
+ * @param[in] table     the FIB table the node belongs to
+ * @param[in] node      the trie node
+ *
+ * @return the entry the node is bound to
+ *         NULL if the node is a branch node
+ */
+static inline fib_entry_t *fib_trie_entry(fib_table_t *table, fib_trie_node_t *node)
+{
+    size_t idx = (size_t)(node - table->trie);
+
+    return (idx < table->size) ? &table->data.entries[idx] : NULL;
+}
+
+/**
+ * @brief returns the length of the trie key of an entry in bits
+ *
+ * @param[in] entry     the FIB entry
+ *
+ * @return 8 bits for the address size plus the prefix length
+ */
+static unsigned fib_trie_key_len(fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    unsigned addr_len = global->address_size << 3;
+    size_t i;
+
+    for (i = 0; (i < global->address_size) && (global->address[i] == 0); i++) {}
+    if (i == global->address_size) {
+        /* default route matches any address of its size */
+        return 8;
+    }
+    if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+        unsigned prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                              >> FIB_FLAG_NET_PREFIX_SHIFT;
+
+        return 8 + ((prefix_len < addr_len) ? prefix_len : addr_len);
+    }
+    return 8 + addr_len;
+}
+
+/**
+ * @brief returns a bit of the trie key of an address
+ *
+ * @param[in] addr      the address
+ * @param[in] addr_size the address size in bytes
+ * @param[in] idx       the bit index, MUST be less than (8 + (addr_size * 8))
+ */
+static inline unsigned fib_trie_key_bit(const uint8_t *addr, size_t addr_size,
+                                        unsigned idx)
+{
+    uint8_t byte = (idx < 8) ? (uint8_t)addr_size : addr[(idx >> 3) - 1];
+
+    return (byte >> (7 - (idx & 7))) & 0x01;
+}
+
+/**
+ * @brief counts the leading bits two trie keys have in common
+ *
+ * @param[in] a         the first address
+ * @param[in] a_size    the size of the first address in bytes
+ * @param[in] b         the second address
+ * @param[in] b_size    the size of the second address in bytes
+ * @param[in] from      number of leading bits already known to be equal
+ * @param[in] limit     maximum number of bits to compare, MUST not exceed
+ *                      the key length of either address
+ *
+ * @return number of equal leading bits, at most @p limit
+ */
+static unsigned fib_trie_match(const uint8_t *a, size_t a_size,
+                               const uint8_t *b, size_t b_size,
+                               unsigned from, unsigned limit)
+{
+    unsigned idx = from;
+
+    while (idx < limit) {
+        unsigned byte = idx >> 3;
+        uint8_t diff = (byte == 0) ? (uint8_t)(a_size ^ b_size)
+                                   : (a[byte - 1] ^ b[byte - 1]);
+
+        diff &= (0xff >> (idx & 7));
+        if (diff == 0) {
+            idx = (byte + 1) << 3;
+            continue;
+        }
+        idx = byte << 3;
+        while (!(diff & 0x80)) {
+            diff <<= 1;
+            idx++;
+        }
+        break;
+    }
+    return (idx < limit) ? idx : limit;
+}
+
+/**
+ * @brief returns an arbitrary entry from the sub-trie below a node
+ */
+static fib_entry_t *fib_trie_any_entry(fib_table_t *table, fib_trie_node_t *node)
+{
+    fib_entry_t *entry;
+
+    /* branch nodes always have two children */
+    while ((entry = fib_trie_entry(table, node)) == NULL) {
+        node = node->child[0];
+    }
+    return entry;
+}
+
+/**
+ * @brief resets the prefix trie of a table to an empty trie
+ */
+static void fib_trie_init(fib_table_t *table)
+{
+    table->trie_root = NULL;
+    table->trie_free = NULL;
+
+    if (table->trie != NULL) {
+        for (size_t i = table->size; i < (table->size << 1); ++i) {
+            table->trie[i].child[0] = table->trie_free;
+            table->trie_free = &table->trie[i];
+        }
+    }
+}
+
+/**
+ * @brief takes a branch node from the unused nodes of the trie
+ */
+static fib_trie_node_t *fib_trie_branch_alloc(fib_table_t *table, unsigned len)
+{
+    fib_trie_node_t *branch = table->trie_free;
+
+    /* a trie with n entries never has more than n - 1 branch nodes */
+    assert(branch != NULL);
+    table->trie_free = branch->child[0];
+    branch->next = NULL;
+    branch->len = len;
+    return branch;
+}
+
+/**
+ * @brief returns a branch node to the unused nodes of the trie
+ */
+static inline void fib_trie_branch_free(fib_table_t *table, fib_trie_node_t *branch)
+{
+    branch->child[0] = table->trie_free;
+    table->trie_free = branch;
+}
+
+/**
+ * @brief adds a (newly created) entry to the prefix trie of its table
+ *
+ * @param[in] table     the FIB table
+ * @param[in] entry     the entry, fib_entry_t::global MUST be set
+ */
+static void fib_trie_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *node = &table->trie[entry - table->data.entries];
+    fib_trie_node_t **link = &table->trie_root;
+    uint8_t *addr = entry->global->address;
+    size_t addr_size = entry->global->address_size;
+
+    node->child[0] = NULL;
+    node->child[1] = NULL;
+    node->next = NULL;
+    node->len = fib_trie_key_len(entry);
+
+    while (*link != NULL) {
+        fib_trie_node_t *cur = *link;
+        universal_address_container_t *other = fib_trie_any_entry(table, cur)->global;
+        unsigned match = fib_trie_match(addr, addr_size, other->address,
+                                        other->address_size, 0,
+                                        (cur->len < node->len) ? cur->len : node->len);
+
+        if (match < cur->len) {
+            unsigned other_bit = fib_trie_key_bit(other->address,
+                                                  other->address_size, match);
+
+            if (match < node->len) {
+                /* the keys differ at bit match: insert a branch above cur */
+                fib_trie_node_t *branch = fib_trie_branch_alloc(table, match);
+
+                branch->child[fib_trie_key_bit(addr, addr_size, match)] = node;
+                node = branch;
+            }
+            /* else the key of entry is a prefix of the key of cur */
+            node->child[other_bit] = cur;
+            *link = node;
+            return;
+        }
+        if (cur->len == node->len) {
+            if (fib_trie_entry(table, cur) == NULL) {
+                /* entry takes the place of a branch node with its key */
+                node->child[0] = cur->child[0];
+                node->child[1] = cur->child[1];
+                *link = node;
+                fib_trie_branch_free(table, cur);
+            }
+            else {
+                while (cur->next != NULL) {
+                    cur = cur->next;
+                }
+                cur->next = node;
+            }
+            return;
+        }
+        link = &cur->child[fib_trie_key_bit(addr, addr_size, cur->len)];
+    }
+    *link = node;
+}
+
+/**
+ * @brief removes an entry from the prefix trie of its table
+ *
+ * @param[in] table     the FIB table
+ * @param[in] entry     the entry, fib_entry_t::global MUST still be set
+ */
+static void fib_trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *node = &table->trie[entry - table->data.entries];
+    fib_trie_node_t **parent_link = NULL, **link = &table->trie_root;
+    uint8_t *addr = entry->global->address;
+    size_t addr_size = entry->global->address_size;
+    unsigned len = fib_trie_key_len(entry);
+
+    while ((*link != NULL) && ((*link)->len < len)) {
+        parent_link = link;
+        link = &(*link)->child[fib_trie_key_bit(addr, addr_size, (*link)->len)];
+    }
+    if ((*link == NULL) || ((*link)->len != len)) {
+        /* entry is not in the trie */
+        return;
+    }
+    if (*link != node) {
+        /* entry shares its key with the entry of *link */
+        for (fib_trie_node_t *cur = *link; cur->next != NULL; cur = cur->next) {
+            if (cur->next == node) {
+                cur->next = node->next;
+                break;
+            }
+        }
+        return;
+    }
+    if (node->next != NULL) {
+        /* next entry with the same key takes the place of node */
+        node->next->child[0] = node->child[0];
+        node->next->child[1] = node->child[1];
+        *link = node->next;
+    }
+    else if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        fib_trie_node_t *branch = fib_trie_branch_alloc(table, len);
+
+        branch->child[0] = node->child[0];
+        branch->child[1] = node->child[1];
+        *link = branch;
+    }
+    else {
+        *link = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+        if ((*link == NULL) && (parent_link != NULL) &&
+            (fib_trie_entry(table, *parent_link) == NULL)) {
+            /* parent branch node has only one child left */
+            fib_trie_node_t *parent = *parent_link;
+
+            *parent_link = (parent->child[0] != NULL) ? parent->child[0]
+                                                      : parent->child[1];
+            fib_trie_branch_free(table, parent);
+        }
+    }
+}
+
+/**
+ * @brief returns the entry for the given destination address using the
+ *        prefix trie of the table
+ *
+ * Parameters and return values are the same as for fib_find_entry()
+ */
+static int fib_trie_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                               fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+    fib_trie_node_t *node = table->trie_root, *best = NULL;
+    unsigned dst_len = 8 + (dst_size << 3);
+    unsigned matched = 0;
+
+    while ((node != NULL) && (node->len <= dst_len)) {
+        fib_entry_t *entry = fib_trie_entry(table, node);
+
+        if (entry != NULL) {
+            /* branch nodes were skipped, so check all bits up to here */
+            matched = fib_trie_match(dst, dst_size, entry->global->address,
+                                     entry->global->address_size, matched,
+                                     node->len);
+            if (matched < node->len) {
+                /* no deeper node can match either */
+                break;
+            }
+            /* an exact match wins over any prefix */
+            for (fib_trie_node_t *cur = node; cur != NULL; cur = cur->next) {
+                universal_address_container_t *global = fib_trie_entry(table, cur)->global;
+
+                if ((global->address_size == dst_size) &&
+                    (memcmp(global->address, dst, dst_size) == 0)) {
+                    entry_arr[0] = fib_trie_entry(table, cur);
+                    *entry_arr_size = 1;
+                    return 1;
+                }
+            }
+            best = node;
+        }
+        if (node->len == dst_len) {
+            break;
+        }
+        node = node->child[fib_trie_key_bit(dst, dst_size, node->len)];
+    }
+
+    if (best == NULL) {
+        *entry_arr_size = 0;
+        return -EHOSTUNREACH;
+    }
+
+    /* of the entries with the longest matching prefix take the one matching
+     * most bits of dst */
+    unsigned best_match = 0;
+    for (fib_trie_node_t *cur = best; cur != NULL; cur = cur->next) {
+        universal_address_container_t *global = fib_trie_entry(table, cur)->global;
+        unsigned match = fib_trie_match(dst, dst_size, global->address,
+                                        global->address_size, best->len, dst_len);
+
+        if ((cur == best) || (match > best_match)) {
+            entry_arr[0] = fib_trie_entry(table, cur);
+            best_match = match;
+        }
+    }
+    *entry_arr_size = 1;
+    return 0;
+}
+
+/**
+ * @brief removes the given entry
+ *
+ * @param[in] table the FIB table the entry belongs to
+ * @param[in] entry the entry to be removed
+ *
+ * @return 0 on success
+ */
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    if (entry->global != NULL) {
+        if (table->trie != NULL) {
+            fib_trie_remove(table, entry);
+        }
+        universal_address_rem(entry->global);
+    }
+
+    if (entry->next_hop) {
+        universal_address_rem(entry->next_hop);
+    }
+
+    entry->global = NULL;
+    entry->global_flags = 0;
+    entry->next_hop = NULL;
+    entry->next_hop_flags = 0;
+
+    entry->iface_id = KERNEL_PID_UNDEF;
+    entry->lifetime = 0;
+
+    return 0;
+}
+
+/**
+ * @brief removes all entries with an expired lifetime
+ *
+ * The table is only scanned if the earliest lifetime of its entries passed.
+ *
+ * @param[in] table     the FIB table
+ * @param[in] now       the current point in time
+ */
+static void fib_expire(fib_table_t *table, uint64_t now)
+{
+    if (now <= table->next_expiry) {
+        return;
+    }
+
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_entry_t *entry = &table->data.entries[i];
+
+        if ((entry->lifetime == 0) || (entry->lifetime == FIB_LIFETIME_NO_EXPIRE)) {
+            continue;
+        }
+        if (entry->lifetime < now) {
+            /* remove this entry if its lifetime expired */
+            fib_remove(table, entry);
+        }
+        else if (entry->lifetime < table->next_expiry) {
+            table->next_expiry = entry->lifetime;
+        }
+    }
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -81,7 +483,11 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
-    uint64_t now = xtimer_now_usec64();
+    fib_expire(table, xtimer_now_usec64());
+
+    if (table->trie != NULL) {
+        return fib_trie_find_entry(table, dst, dst_size, entry_arr, entry_arr_size);
+    }
 
     size_t count = 0;
     size_t prefix_size = 0;
@@ -105,30 +511,6 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     }
 
     for (size_t i = 0; i < table->size; ++i) {
-
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
-
-            /* check if the lifetime expired */
-            if (table->data.entries[i].lifetime < now) {
-                /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
-
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
-                }
-            }
-        }
-
         if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)) {
 
             int ret_comp = universal_address_compare(table->data.entries[i].global, dst, &match_size);
@@ -192,6 +574,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table the entry belongs to
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -201,7 +584,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry, uint8_t *next_hop,
                          size_t next_hop_size, uint32_t next_hop_flags,
                          uint32_t lifetime)
 {
@@ -217,6 +600,9 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
 
     if (lifetime != (uint32_t)FIB_LIFETIME_NO_EXPIRE) {
         fib_lifetime_to_absolute(lifetime, &entry->lifetime);
+        if (entry->lifetime < table->next_expiry) {
+            table->next_expiry = entry->lifetime;
+        }
     }
     else {
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
@@ -255,6 +641,13 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                 table->data.entries[i].global_flags = dst_flags;
                 table->data.entries[i].next_hop = universal_address_add(next_hop, next_hop_size);
                 table->data.entries[i].next_hop_flags = next_hop_flags;
+
+                if (table->data.entries[i].next_hop == NULL) {
+                    /* do not leak the destination address */
+                    universal_address_rem(table->data.entries[i].global);
+                    table->data.entries[i].global = NULL;
+                    table->data.entries[i].global_flags = 0;
+                }
             }
 
             if (table->data.entries[i].next_hop != NULL) {
@@ -263,11 +656,18 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 
                 if (lifetime != (uint32_t) FIB_LIFETIME_NO_EXPIRE) {
                     fib_lifetime_to_absolute(lifetime, &table->data.entries[i].lifetime);
+                    if (table->data.entries[i].lifetime < table->next_expiry) {
+                        table->next_expiry = table->data.entries[i].lifetime;
+                    }
                 }
                 else {
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+                if (table->trie != NULL) {
+                    fib_trie_insert(table, &table->data.entries[i]);
+                }
+
                 return 0;
             }
         }
@@ -276,34 +676,6 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
     return -ENOMEM;
 }
 
-/**
- * @brief removes the given entry
- *
- * @param[in] entry the entry to be removed
- *
- * @return 0 on success
- */
-static int fib_remove(fib_entry_t *entry)
-{
-    if (entry->global != NULL) {
-        universal_address_rem(entry->global);
-    }
-
-    if (entry->next_hop) {
-        universal_address_rem(entry->next_hop);
-    }
-
-    entry->global = NULL;
-    entry->global_flags = 0;
-    entry->next_hop = NULL;
-    entry->next_hop_flags = 0;
-
-    entry->iface_id = KERNEL_PID_UNDEF;
-    entry->lifetime = 0;
-
-    return 0;
-}
-
 /**
  * @brief signals (sends a message to) all registered routing protocols
  *        registered with a matching prefix (usually this should be only one).
@@ -403,7 +775,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -433,7 +805,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -457,7 +829,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +849,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -596,7 +968,9 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        fib_trie_init(table);
     }
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -621,7 +995,9 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        fib_trie_init(table);
     }
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
@@ -61,7 +61,11 @@ void ps(void)
 #endif
             "%-9sQ | pri "
 #ifdef DEVELHELP
-           "| stack  ( used) | base addr  | current     "
+           "| stack  ( used) "
+#ifdef MODULE_CORE_STACK_HWM
+           "| min used "
+#endif
+           "| base addr  | current     "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime  | switches"
@@ -106,6 +110,10 @@ void ps(void)
             overall_stacksz += stacksz;
             stacksz -= thread_measure_stack_free(p->stack_start);
             overall_used += stacksz;
+#ifdef MODULE_CORE_STACK_HWM
+            /* tracked on context switches only, so a lower bound */
+            int hwm_used = p->stack_size - thread_stack_hwm_free(i);
+#endif
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
             /* multiply with 100 for percentage and to avoid floats/doubles */
@@ -120,7 +128,11 @@ void ps(void)
 #endif
                    " | %-8s %.1s | %3i"
 #ifdef DEVELHELP
-                   " | %6i (%5i) | %10p | %10p "
+                   " | %6i (%5i)"
+#ifdef MODULE_CORE_STACK_HWM
+                   " | %8i"
+#endif
+                   " | %10p | %10p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %2d.%03d%% |  %8u"
@@ -132,7 +144,11 @@ void ps(void)
 #endif
                    sname, queued, p->priority
 #ifdef DEVELHELP
-                   , p->stack_size, stacksz, (void *)p->stack_start, (void *)p->sp
+                   , p->stack_size, stacksz
+#ifdef MODULE_CORE_STACK_HWM
+                   , hwm_used
+#endif
+                   , (void *)p->stack_start, (void *)p->sp
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_major, runtime_minor, switches
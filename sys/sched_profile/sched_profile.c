@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_profile
+ * @{
+ *
+ * @file
+ * @brief       Scheduler profiling implementation
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "sched_profile.h"
+#include "thread.h"
+#include "xtimer.h"
+
+enum {
+    EVENT_SWITCH = 0,
+    EVENT_ISR_ENTER,
+    EVENT_ISR_EXIT,
+};
+
+typedef struct {
+    uint32_t time;
+    kernel_pid_t pid;
+    uint8_t type;
+} _event_t;
+
+sched_profile_t sched_profile[KERNEL_PID_LAST + 1];
+sched_profile_isr_t sched_profile_isr;
+
+static _event_t _trace[SCHED_PROFILE_TRACE_SIZE];
+static unsigned _trace_next, _trace_numof;
+static volatile bool _paused;
+static uint32_t _isr_start;
+
+static const char *_blocked_names[] = {
+    [SCHED_PROFILE_BLOCKED_MSG] = "msg",
+    [SCHED_PROFILE_BLOCKED_MUTEX] = "mutex",
+    [SCHED_PROFILE_BLOCKED_FLAGS] = "flags",
+    [SCHED_PROFILE_BLOCKED_MBOX] = "mbox",
+    [SCHED_PROFILE_BLOCKED_SLEEP] = "sleep",
+};
+
+static int _blocked_reason(unsigned status)
+{
+    switch (status) {
+        case STATUS_SEND_BLOCKED:
+        case STATUS_RECEIVE_BLOCKED:
+        case STATUS_REPLY_BLOCKED:
+            return SCHED_PROFILE_BLOCKED_MSG;
+        case STATUS_MUTEX_BLOCKED:
+            return SCHED_PROFILE_BLOCKED_MUTEX;
+        case STATUS_FLAG_BLOCKED_ANY:
+        case STATUS_FLAG_BLOCKED_ALL:
+            return SCHED_PROFILE_BLOCKED_FLAGS;
+        case STATUS_MBOX_BLOCKED:
+            return SCHED_PROFILE_BLOCKED_MBOX;
+        case STATUS_SLEEPING:
+            return SCHED_PROFILE_BLOCKED_SLEEP;
+        default:
+            return -1;
+    }
+}
+
+static void _record(uint32_t time, kernel_pid_t pid, uint8_t type)
+{
+    if (_paused) {
+        return;
+    }
+    _trace[_trace_next].time = time;
+    _trace[_trace_next].pid = pid;
+    _trace[_trace_next].type = type;
+    _trace_next = (_trace_next + 1) % SCHED_PROFILE_TRACE_SIZE;
+    if (_trace_numof < SCHED_PROFILE_TRACE_SIZE) {
+        _trace_numof++;
+    }
+}
+
+void sched_profile_status(thread_t *thread, unsigned status)
+{
+    sched_profile_t *prof = &sched_profile[thread->pid];
+    uint32_t now = xtimer_now().ticks32;
+    int reason = _blocked_reason(thread->status);
+
+    if (thread->status == status) {
+        return;
+    }
+    if (reason >= 0) {
+        prof->blocked[reason] += now - prof->status_since;
+    }
+    if ((status == STATUS_PENDING) && (thread->status < STATUS_ON_RUNQUEUE)) {
+        prof->woken = 1;
+        prof->woken_at = now;
+    }
+    prof->status_since = now;
+}
+
+void sched_profile_switch(thread_t *next, uint32_t now)
+{
+    sched_profile_t *prof = &sched_profile[next->pid];
+
+    if (prof->woken) {
+        uint32_t latency = now - prof->woken_at;
+
+        prof->latency_max = (latency > prof->latency_max) ? latency
+                                                          : prof->latency_max;
+        prof->woken = 0;
+    }
+    _record(now, next->pid, EVENT_SWITCH);
+}
+
+void sched_profile_isr_enter(void)
+{
+    _isr_start = xtimer_now().ticks32;
+    _record(_isr_start, KERNEL_PID_UNDEF, EVENT_ISR_ENTER);
+}
+
+void sched_profile_isr_exit(void)
+{
+    uint32_t now = xtimer_now().ticks32;
+    uint32_t ticks = now - _isr_start;
+
+    sched_profile_isr.ticks += ticks;
+    sched_profile_isr.count++;
+    sched_profile_isr.max = (ticks > sched_profile_isr.max) ? ticks
+                                                            : sched_profile_isr.max;
+    _record(now, KERNEL_PID_UNDEF, EVENT_ISR_EXIT);
+}
+
+void sched_profile_reset(void)
+{
+    unsigned state = irq_disable();
+    uint32_t now = xtimer_now().ticks32;
+
+    memset(sched_profile, 0, sizeof(sched_profile));
+    memset(&sched_profile_isr, 0, sizeof(sched_profile_isr));
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        sched_profile[i].status_since = now;
+    }
+    _trace_next = 0;
+    _trace_numof = 0;
+    irq_restore(state);
+}
+
+static const char *_name(kernel_pid_t pid)
+{
+    const char *name = thread_getname(pid);
+
+    return (name) ? name : "-";
+}
+
+void sched_profile_print(void)
+{
+    printf("\tpid | %-20s|", "name");
+    for (unsigned i = 0; i < SCHED_PROFILE_BLOCKED_NUMOF; i++) {
+        printf(" %10s |", _blocked_names[i]);
+    }
+    puts(" latency max (us)");
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        sched_profile_t *prof = &sched_profile[pid];
+
+        if (sched_threads[pid] == NULL) {
+            continue;
+        }
+        printf("\t%3" PRIkernel_pid " | %-20s|", pid, _name(pid));
+        for (unsigned i = 0; i < SCHED_PROFILE_BLOCKED_NUMOF; i++) {
+            printf(" %10" PRIu32 " |",
+                   (uint32_t)_xtimer_usec_from_ticks64(prof->blocked[i]));
+        }
+        printf(" %" PRIu32 "\n", _xtimer_usec_from_ticks(prof->latency_max));
+    }
+    printf("\tisr: %" PRIu32 " times, %" PRIu32 " us total, %" PRIu32
+           " us max\n", sched_profile_isr.count,
+           (uint32_t)_xtimer_usec_from_ticks64(sched_profile_isr.ticks),
+           _xtimer_usec_from_ticks(sched_profile_isr.max));
+}
+
+static void _print_event(const char *ph, kernel_pid_t pid, uint32_t usec,
+                         bool *first)
+{
+    printf("%s\n{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%" PRIu32
+           ",\"pid\":0,\"tid\":%" PRIkernel_pid "}",
+           (*first) ? "" : ",", (pid == KERNEL_PID_UNDEF) ? "isr" : _name(pid),
+           ph, usec, pid);
+    *first = false;
+}
+
+void sched_profile_print_trace(void)
+{
+    _paused = true;
+
+    unsigned numof = _trace_numof;
+    unsigned idx = (_trace_next + SCHED_PROFILE_TRACE_SIZE - numof) %
+                   SCHED_PROFILE_TRACE_SIZE;
+    uint32_t base = _trace[idx].time;
+    kernel_pid_t running = KERNEL_PID_UNDEF;
+    bool first = true;
+
+    printf("{\"traceEvents\":[");
+    for (unsigned i = 0; i < numof; i++) {
+        _event_t *event = &_trace[(idx + i) % SCHED_PROFILE_TRACE_SIZE];
+        uint32_t usec = _xtimer_usec_from_ticks(event->time - base);
+
+        switch (event->type) {
+            case EVENT_SWITCH:
+                if (running != KERNEL_PID_UNDEF) {
+                    _print_event("E", running, usec, &first);
+                }
+                _print_event("B", event->pid, usec, &first);
+                running = event->pid;
+                break;
+            case EVENT_ISR_ENTER:
+                _print_event("B", KERNEL_PID_UNDEF, usec, &first);
+                break;
+            default:
+                _print_event("E", KERNEL_PID_UNDEF, usec, &first);
+                break;
+        }
+    }
+    puts("\n]}");
+    _paused = false;
+}
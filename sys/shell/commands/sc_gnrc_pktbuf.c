@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command to print the statistics of the packet buffer
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
+
+static void _usage(char *cmd_str)
+{
+#ifdef DEVELHELP
+    printf("usage: %s [dump]\n", cmd_str);
+#else
+    printf("usage: %s\n", cmd_str);
+#endif
+}
+
+int _gnrc_pktbuf_cmd(int argc, char **argv)
+{
+    gnrc_pktbuf_stats_t stats;
+
+    if (argc > 1) {
+#ifdef DEVELHELP
+        if (strcmp(argv[1], "dump") == 0) {
+            gnrc_pktbuf_stats();
+            return 0;
+        }
+#endif
+        _usage(argv[0]);
+        return 1;
+    }
+    gnrc_pktbuf_get_stats(&stats);
+    printf("packet buffer: %u bytes\n", (unsigned)GNRC_PKTBUF_SIZE);
+    printf("  used: %u bytes (peak: %u bytes), largest free chunk: %u bytes\n",
+           (unsigned)stats.used, (unsigned)stats.used_peak,
+           (unsigned)stats.largest_free);
+    printf("  allocated chunks: %" PRIu32 ", released chunks: %" PRIu32 "\n",
+           stats.allocs, stats.frees);
+    printf("  failed allocations: %" PRIu32 " (due to fragmentation: %" PRIu32 ")\n",
+           stats.alloc_fails, stats.alloc_fails_frag);
+    puts("  snips created per type:");
+    for (int type = GNRC_NETTYPE_IOVEC; type < GNRC_NETTYPE_NUMOF; type++) {
+        uint32_t snips = gnrc_pktbuf_stats_snips(&stats, type);
+
+        if (snips > 0) {
+            printf("    type %3d: %" PRIu32 "\n", type, snips);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell commands for the scheduler profiling module
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sched_profile.h"
+
+int _sched_profile_handler(int argc, char **argv)
+{
+    if (argc < 2) {
+        sched_profile_print();
+    }
+    else if (strcmp(argv[1], "trace") == 0) {
+        sched_profile_print_trace();
+    }
+    else if (strcmp(argv[1], "reset") == 0) {
+        sched_profile_reset();
+    }
+    else {
+        printf("usage: %s [trace|reset]\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
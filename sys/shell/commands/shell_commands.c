@@ -37,6 +37,10 @@ extern int _heap_handler(int argc, char **argv);
 extern int _ps_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_SCHED_PROFILE
+extern int _sched_profile_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_SHT11
 extern int _get_temperature_handler(int argc, char **argv);
 extern int _get_humidity_handler(int argc, char **argv);
@@ -91,6 +95,10 @@ extern int _gnrc_netif_send(int argc, char **argv);
 #endif
 #endif
 
+#ifdef MODULE_GNRC_PKTBUF
+extern int _gnrc_pktbuf_cmd(int argc, char **argv);
+#endif
+
 #ifdef MODULE_FIB
 extern int _fib_route_handler(int argc, char **argv);
 #endif
@@ -149,6 +157,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
 #endif
+#ifdef MODULE_SCHED_PROFILE
+    {"schedprof", "Prints the scheduler profile or trace", _sched_profile_handler},
+#endif
 #ifdef MODULE_SHT11
     {"temp", "Prints measured temperature.", _get_temperature_handler},
     {"hum", "Prints measured humidity.", _get_humidity_handler},
@@ -190,6 +201,9 @@ const shell_command_t _shell_command_list[] = {
     {"txtsnd", "Sends a custom string as is over the link layer", _gnrc_netif_send },
 #endif
 #endif
+#ifdef MODULE_GNRC_PKTBUF
+    {"pktbuf", "Shows packet buffer statistics", _gnrc_pktbuf_cmd},
+#endif
 #ifdef MODULE_FIB
     {"fibroute", "Manipulate the FIB (info: 'fibroute [add|del]')", _fib_route_handler},
 #endif
@@ -26,6 +26,7 @@
 #endif
 #endif
 #include "mutex.h"
+#include "objpool.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -47,20 +48,101 @@
 #endif
 
 /**
- * @brief counter indicating the number of entries allocated
+ * @brief Number of slots of the address index
+ *
+ * Odd, so it is never zero and at most half of the slots are ever occupied.
  */
-static size_t universal_address_table_filled = 0;
+#define UNIVERSAL_ADDRESS_IDX_NUMOF ((2 * UNIVERSAL_ADDRESS_MAX_ENTRIES) + 1)
 
 /**
  * @brief The array of universal_address containers
  */
 static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_MAX_ENTRIES];
 
+/**
+ * @brief Containers with a use_count > 0, counting the entries allocated
+ */
+static unsigned universal_address_table_used[OBJPOOL_BITMAP_NUMOF(UNIVERSAL_ADDRESS_MAX_ENTRIES)];
+static objpool_t universal_address_pool = OBJPOOL_INIT(universal_address_table,
+                                                       universal_address_table_used);
+
+/**
+ * @brief Open addressing hash index over all containers holding an address
+ *        (i.e. with an address_size > 0), used or not.
+ *
+ * A slot holds the position of the container in universal_address_table
+ * plus 1, 0 marks an empty slot.
+ */
+#if UNIVERSAL_ADDRESS_MAX_ENTRIES < UINT8_MAX
+static uint8_t universal_address_idx[UNIVERSAL_ADDRESS_IDX_NUMOF];
+#else
+static uint16_t universal_address_idx[UNIVERSAL_ADDRESS_IDX_NUMOF];
+#endif
+
 /**
  * @brief access mutex to control exclusive operations on calls
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+/**
+ * @brief returns the home slot of an address in universal_address_idx
+ */
+static size_t universal_address_idx_hash(const uint8_t *addr, size_t addr_size)
+{
+    /* FNV-1a over the address size and the address */
+    uint32_t hash = (2166136261U ^ (uint32_t)addr_size) * 16777619U;
+
+    for (size_t i = 0; i < addr_size; ++i) {
+        hash = (hash ^ addr[i]) * 16777619U;
+    }
+    return hash % UNIVERSAL_ADDRESS_IDX_NUMOF;
+}
+
+/**
+ * @brief adds a container to the address index
+ */
+static void universal_address_idx_add(universal_address_container_t *entry)
+{
+    size_t pos = universal_address_idx_hash(entry->address, entry->address_size);
+
+    while (universal_address_idx[pos] != 0) {
+        pos = (pos + 1) % UNIVERSAL_ADDRESS_IDX_NUMOF;
+    }
+    universal_address_idx[pos] = (entry - universal_address_table) + 1;
+}
+
+/**
+ * @brief removes a container from the address index
+ */
+static void universal_address_idx_rem(universal_address_container_t *entry)
+{
+    size_t hole = universal_address_idx_hash(entry->address, entry->address_size);
+    size_t val = (entry - universal_address_table) + 1;
+
+    while (universal_address_idx[hole] != val) {
+        if (universal_address_idx[hole] == 0) {
+            /* not indexed */
+            return;
+        }
+        hole = (hole + 1) % UNIVERSAL_ADDRESS_IDX_NUMOF;
+    }
+    /* shift following slots of the probe sequence back into the hole */
+    for (size_t pos = (hole + 1) % UNIVERSAL_ADDRESS_IDX_NUMOF;
+         universal_address_idx[pos] != 0;
+         pos = (pos + 1) % UNIVERSAL_ADDRESS_IDX_NUMOF) {
+        universal_address_container_t *other =
+            &universal_address_table[universal_address_idx[pos] - 1];
+        size_t home = universal_address_idx_hash(other->address, other->address_size);
+
+        if (((pos + UNIVERSAL_ADDRESS_IDX_NUMOF - home) % UNIVERSAL_ADDRESS_IDX_NUMOF) >=
+            ((pos + UNIVERSAL_ADDRESS_IDX_NUMOF - hole) % UNIVERSAL_ADDRESS_IDX_NUMOF)) {
+            universal_address_idx[hole] = universal_address_idx[pos];
+            hole = pos;
+        }
+    }
+    universal_address_idx[hole] = 0;
+}
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,6 +154,22 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
+    if (addr_size > 0) {
+        size_t pos = universal_address_idx_hash(addr, addr_size);
+
+        while (universal_address_idx[pos] != 0) {
+            universal_address_container_t *entry =
+                &universal_address_table[universal_address_idx[pos] - 1];
+
+            if ((entry->address_size == addr_size) &&
+                (memcmp(entry->address, addr, addr_size) == 0)) {
+                return entry;
+            }
+            pos = (pos + 1) % UNIVERSAL_ADDRESS_IDX_NUMOF;
+        }
+        return NULL;
+    }
+
     /* cppcheck-suppress unsignedLessThanZero
      * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
      * code is optimized out) */
@@ -94,19 +192,7 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
  */
 static universal_address_container_t *universal_address_get_next_unused_entry(void)
 {
-    /* cppcheck-suppress unsignedLessThanZero
-     * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
-     * code is optimized out) */
-    if (universal_address_table_filled < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
-        /* cppcheck-suppress unsignedLessThanZero */
-        for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-            if (universal_address_table[i].use_count == 0) {
-                return &(universal_address_table[i]);
-            }
-        }
-    }
-
-    return NULL;
+    return objpool_alloc(&universal_address_pool);
 }
 
 universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_size)
@@ -124,6 +210,11 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
             return NULL;
         }
 
+        if (pEntry->address_size > 0) {
+            /* the former address of this container is replaced */
+            universal_address_idx_rem(pEntry);
+        }
+
         /* look if the former memory has distinct size */
         if (pEntry->address_size != addr_size) {
             /* clean the address */
@@ -136,14 +227,19 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+
+        if (addr_size > 0) {
+            universal_address_idx_add(pEntry);
+        }
     }
 
     pEntry->use_count++;
 
     if (pEntry->use_count == 1) {
         DEBUG("[universal_address_add] universal_address_table_filled: %d\n", \
-              (int)universal_address_table_filled);
-        universal_address_table_filled++;
+              (int)universal_address_pool.count);
+        /* an unused container found by its address is revived */
+        objpool_take(&universal_address_pool, pEntry);
     }
 
     mutex_unlock(&mtx_access);
@@ -161,12 +257,12 @@ void universal_address_rem(universal_address_container_t *entry)
             entry->use_count--;
 
             if (entry->use_count == 0) {
-                universal_address_table_filled--;
+                objpool_free(&universal_address_pool, entry);
             }
         }
         else {
             DEBUG("[universal_address_rem] universal_address_table_filled: %d\n", \
-                  (int)universal_address_table_filled);
+                  (int)universal_address_pool.count);
         }
     }
 
@@ -309,6 +405,10 @@ void universal_address_init(void)
         universal_address_table[i].address_size = 0;
         memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
     }
+    memset(universal_address_idx, 0, sizeof(universal_address_idx));
+    objpool_init(&universal_address_pool, universal_address_table,
+                 sizeof(universal_address_container_t),
+                 UNIVERSAL_ADDRESS_MAX_ENTRIES, universal_address_table_used);
 
     mutex_unlock(&mtx_access);
 }
@@ -324,7 +424,9 @@ void universal_address_reset(void)
         universal_address_table[i].use_count = 0;
     }
 
-    universal_address_table_filled = 0;
+    objpool_init(&universal_address_pool, universal_address_table,
+                 sizeof(universal_address_container_t),
+                 UNIVERSAL_ADDRESS_MAX_ENTRIES, universal_address_table_used);
     mutex_unlock(&mtx_access);
 }
 
@@ -351,7 +453,7 @@ address_size: %d, content: ", \
 int universal_address_get_num_used_entries(void)
 {
     mutex_lock(&mtx_access);
-    size_t ret = universal_address_table_filled;
+    size_t ret = universal_address_pool.count;
     mutex_unlock(&mtx_access);
     return ret;
 }
@@ -359,7 +461,7 @@ int universal_address_get_num_used_entries(void)
 void universal_address_print_table(void)
 {
     printf("[universal_address_print_table] universal_address_table_filled: %d\n", \
-           (int)universal_address_table_filled);
+           (int)universal_address_pool.count);
 
     /* cppcheck-suppress unsignedLessThanZero
      * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
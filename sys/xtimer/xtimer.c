@@ -242,6 +242,12 @@ static void _mutex_timeout(void *arg)
     if ((node != NULL) && (mt->mutex->queue.next == NULL)) {
         mt->mutex->queue.next = MUTEX_LOCKED;
     }
+#ifdef MODULE_CORE_MUTEX_PI
+    if (node != NULL) {
+        /* the owner may have inherited the priority of the leaving thread */
+        mutex_pi_update(mt->mutex);
+    }
+#endif
     sched_set_status(mt->thread, STATUS_PENDING);
     thread_yield_higher();
 }
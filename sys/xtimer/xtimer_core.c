@@ -24,6 +24,12 @@
 #include "xtimer.h"
 #include "irq.h"
 
+#ifdef MODULE_XTIMER_TICKLESS
+#include "kernel_init.h"
+#include "periph/pm.h"
+#include "periph/rtt.h"
+#endif
+
 /* WARNING! enabling this will have side effects and can lead to timer underflows. */
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -34,6 +40,9 @@ static volatile uint32_t _long_cnt = 0;
 #if XTIMER_MASK
 volatile uint32_t _xtimer_high_cnt = 0;
 #endif
+#ifdef MODULE_XTIMER_TICKLESS
+volatile uint32_t _xtimer_lltimer_offset = 0;
+#endif
 
 static inline void xtimer_spin_until(uint32_t value);
 
@@ -43,6 +52,7 @@ static xtimer_t *long_list_head = NULL;
 
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
+static xtimer_t *_pop_timer(xtimer_t **list_head);
 static void _shoot(xtimer_t *timer);
 static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
@@ -53,6 +63,10 @@ static void _periph_timer_callback(void *arg, int chan);
 
 static inline int _this_high_period(uint32_t target);
 
+#ifdef MODULE_XTIMER_WAKEUPS
+static xtimer_wakeups_t _wakeups;
+#endif
+
 static inline int _is_set(xtimer_t *timer)
 {
     return (timer->target || timer->long_target);
@@ -70,6 +84,9 @@ void xtimer_init(void)
 {
     /* initialize low-level timer */
     timer_init(XTIMER_DEV, XTIMER_HZ, _periph_timer_callback, NULL);
+#ifdef MODULE_XTIMER_TICKLESS
+    rtt_init();
+#endif
 
     /* register initial overflow tick */
     _lltimer_set(0xFFFFFFFF);
@@ -151,6 +168,14 @@ static void _periph_timer_callback(void *arg, int chan)
 {
     (void)arg;
     (void)chan;
+#ifdef MODULE_XTIMER_WAKEUPS
+    if (timer_list_head) {
+        _wakeups.timers++;
+    }
+    else {
+        _wakeups.overflows++;
+    }
+#endif
     _timer_callback();
 }
 
@@ -165,6 +190,9 @@ static inline void _lltimer_set(uint32_t target)
         return;
     }
     DEBUG("_lltimer_set(): setting %" PRIu32 "\n", _xtimer_lltimer_mask(target));
+#ifdef MODULE_XTIMER_TICKLESS
+    target -= _xtimer_lltimer_offset;
+#endif
     timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _xtimer_lltimer_mask(target));
 }
 
@@ -175,9 +203,15 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
 
     DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
 
+#ifndef MODULE_XTIMER_HEAP
     timer->next = NULL;
+#endif
     if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
         /* backoff */
+#ifdef MODULE_XTIMER_HEAP
+        /* a timer still linked into a heap must not be shot */
+        xtimer_remove(timer);
+#endif
         xtimer_spin_until(target + XTIMER_BACKOFF);
         _shoot(timer);
         return 0;
@@ -219,6 +253,159 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     return res;
 }
 
+#ifdef MODULE_XTIMER_HEAP
+/*
+ * Timer lists are pairing heaps: the head of a list is the root of its heap,
+ * xtimer_t::child points to the first child of a timer and xtimer_t::next to
+ * its next sibling. xtimer_t::prev points to the previous sibling or, for the
+ * first child, to the parent, so any timer can be unlinked without knowing
+ * which heap it is in.
+ */
+
+/**
+ * @brief returns true if @p a expires no later than @p b
+ *
+ * (long_target, target) is the absolute target time of every timer, so the
+ * same order serves the short and the long term heaps.
+ */
+static inline int _heap_before(const xtimer_t *a, const xtimer_t *b)
+{
+    return (a->long_target < b->long_target) ||
+           ((a->long_target == b->long_target) && (a->target <= b->target));
+}
+
+/**
+ * @brief meld two heaps, return root of the new heap
+ */
+static xtimer_t *_heap_meld(xtimer_t *a, xtimer_t *b)
+{
+    if (!_heap_before(a, b)) {
+        xtimer_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    /* b becomes first child of a */
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+/**
+ * @brief meld a list of siblings into one heap (two-pass), return its root
+ */
+static xtimer_t *_heap_merge_pairs(xtimer_t *first)
+{
+    xtimer_t *pairs = NULL;
+    xtimer_t *root;
+
+    /* first pass: meld siblings pairwise from left to right, the resulting
+     * heaps are kept in reverse order in pairs */
+    while (first) {
+        xtimer_t *a = first;
+        xtimer_t *b = first->next;
+
+        first = (b) ? b->next : NULL;
+        a->next = NULL;
+        a->prev = NULL;
+        if (b) {
+            b->next = NULL;
+            b->prev = NULL;
+            a = _heap_meld(a, b);
+        }
+        a->next = pairs;
+        pairs = a;
+    }
+    /* second pass: meld the resulting heaps from right to left */
+    root = pairs;
+    if (root) {
+        pairs = root->next;
+        root->next = NULL;
+    }
+    while (pairs) {
+        xtimer_t *a = pairs;
+
+        pairs = a->next;
+        a->next = NULL;
+        root = _heap_meld(root, a);
+    }
+
+    return root;
+}
+
+/**
+ * @brief remove a timer that is not the root from its heap
+ */
+static void _heap_unlink(xtimer_t *timer)
+{
+    /* the children of timer take its place. They all expire after the parent
+     * of timer, so the heap order is kept */
+    xtimer_t *repl = _heap_merge_pairs(timer->child);
+
+    if (repl) {
+        repl->next = timer->next;
+        if (timer->next) {
+            timer->next->prev = repl;
+        }
+    }
+    else {
+        repl = timer->next;
+    }
+    if (repl) {
+        repl->prev = timer->prev;
+    }
+    if (timer->prev->child == timer) {
+        timer->prev->child = repl;
+    }
+    else {
+        timer->prev->next = repl;
+    }
+    timer->next = NULL;
+    timer->prev = NULL;
+    timer->child = NULL;
+}
+
+static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    timer->next = NULL;
+    timer->prev = NULL;
+    timer->child = NULL;
+    *list_head = (*list_head) ? _heap_meld(*list_head, timer) : timer;
+}
+
+static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    _add_timer_to_list(list_head, timer);
+}
+
+static xtimer_t *_pop_timer(xtimer_t **list_head)
+{
+    xtimer_t *timer = *list_head;
+
+    *list_head = _heap_merge_pairs(timer->child);
+    timer->child = NULL;
+
+    return timer;
+}
+
+static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    if (*list_head == timer) {
+        _pop_timer(list_head);
+        return 1;
+    }
+    if (timer->prev) {
+        _heap_unlink(timer);
+        return 1;
+    }
+
+    return 0;
+}
+#else
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
 {
     while (*list_head && (*list_head)->target <= timer->target) {
@@ -241,6 +428,15 @@ static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer)
     *list_head = timer;
 }
 
+static xtimer_t *_pop_timer(xtimer_t **list_head)
+{
+    xtimer_t *timer = *list_head;
+
+    *list_head = timer->next;
+
+    return timer;
+}
+
 static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
 {
     while (*list_head) {
@@ -253,12 +449,13 @@ static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
 
     return 0;
 }
+#endif
 
 static void _remove(xtimer_t *timer)
 {
     if (timer_list_head == timer) {
         uint32_t next;
-        timer_list_head = timer->next;
+        _pop_timer(&timer_list_head);
         if (timer_list_head) {
             /* schedule callback on next timer target time */
             next = timer_list_head->target - XTIMER_OVERHEAD;
@@ -311,6 +508,21 @@ static inline int _this_high_period(uint32_t target) {
 #endif
 }
 
+#ifdef MODULE_XTIMER_HEAP
+/**
+ * @brief move the long term timers that will expire in the current short
+ *        timer period to the current timer heap
+ */
+static void _select_long_timers(void)
+{
+    while (long_list_head && (long_list_head->long_target <= _long_cnt) &&
+           _this_high_period(long_list_head->target)) {
+        xtimer_t *timer = _pop_timer(&long_list_head);
+
+        _add_timer_to_list(&timer_list_head, timer);
+    }
+}
+#else
 /**
  * @brief compare two timers' target values, return the one with lower value.
  *
@@ -400,6 +612,7 @@ static void _select_long_timers(void)
         }
     }
 }
+#endif
 
 /**
  * @brief handle low-level timer overflow, advance to next short timer period
@@ -468,11 +681,8 @@ overflow:
         /* make sure we don't fire too early */
         while (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference)) {}
 
-        /* pick first timer in list */
-        xtimer_t *timer = timer_list_head;
-
-        /* advance list */
-        timer_list_head = timer->next;
+        /* pick first timer in list and advance list */
+        xtimer_t *timer = _pop_timer(&timer_list_head);
 
         /* make sure timer is recognized as being already fired */
         timer->target = 0;
@@ -532,3 +742,160 @@ overflow:
     /* set low level timer */
     _lltimer_set(next_target);
 }
+
+#ifdef MODULE_XTIMER_TICKLESS
+/* length of a low-level timer period in ticks */
+#if XTIMER_MASK
+#define PERIOD_TICKS    ((uint64_t)(~XTIMER_MASK) + 1)
+#else
+#define PERIOD_TICKS    ((uint64_t)1 << 32)
+#endif
+
+/* resolution of the RTT in ticks of the low-level timer */
+#define RTT_TICK_TICKS  (_xtimer_ticks_from_usec(US_PER_SEC / RTT_FREQUENCY) + 1)
+
+static void _rtt_cb(void *arg)
+{
+    /* only there to wake up the CPU */
+    (void)arg;
+}
+
+/**
+ * @brief   get the absolute target of the next timer after the current
+ *          period, UINT64_MAX if there is none
+ */
+static uint64_t _next_deadline(uint64_t period_end)
+{
+    uint64_t deadline = UINT64_MAX;
+
+    if (overflow_list_head) {
+        deadline = period_end +
+                   _xtimer_lltimer_mask(overflow_list_head->target);
+    }
+    if (long_list_head) {
+        uint64_t target = ((uint64_t)long_list_head->long_target << 32) |
+                          long_list_head->target;
+        deadline = (target < deadline) ? target : deadline;
+    }
+    return deadline;
+}
+
+void xtimer_tickless_idle(void)
+{
+    unsigned state = irq_disable();
+    uint64_t now = _xtimer_now64();
+    uint32_t ll_start = _xtimer_lltimer_mask((uint32_t)now);
+    uint64_t period_end = now - ll_start + PERIOD_TICKS;
+    uint64_t margin = _xtimer_ticks_from_usec(XTIMER_TICKLESS_MARGIN);
+    uint64_t deadline = _next_deadline(period_end);
+
+    /* timers in the current period and an overflow that is about to happen
+     * are left to the low-level timer */
+    if (timer_list_head || (now + margin >= period_end) ||
+        (deadline < period_end + margin)) {
+        irq_restore(state);
+        pm_set_lowest();
+        return;
+    }
+
+    uint64_t usec = _xtimer_usec_from_ticks64(deadline - margin - now);
+    uint64_t rtt_ticks = (usec * RTT_FREQUENCY) / US_PER_SEC;
+    uint32_t rtt_start = rtt_get_counter();
+
+    /* keep the elapsed time unambiguous */
+    if (rtt_ticks > (RTT_MAX_VALUE >> 1)) {
+        rtt_ticks = RTT_MAX_VALUE >> 1;
+    }
+    DEBUG("xtimer_tickless_idle(): sleeping %" PRIu32 " RTT ticks\n",
+          (uint32_t)rtt_ticks);
+    timer_clear(XTIMER_DEV, XTIMER_CHAN);
+    rtt_set_alarm((rtt_start + (uint32_t)rtt_ticks) & RTT_MAX_VALUE,
+                  _rtt_cb, NULL);
+
+    /* returns with interrupts still disabled on any interrupt, so nobody
+     * reads the time before it is advanced below */
+    pm_set_lowest();
+
+    rtt_clear_alarm();
+    uint32_t elapsed = (rtt_get_counter() - rtt_start) & RTT_MAX_VALUE;
+    uint64_t passed = _xtimer_ticks_from_usec64(((uint64_t)elapsed *
+                                                 US_PER_SEC) / RTT_FREQUENCY);
+    uint32_t ll_now = _xtimer_lltimer_now();
+    int64_t total = (int64_t)(ll_start + passed);
+
+    /* the RTT is far more precise than a period, so round to the number of
+     * overflows that fit the low-level timer's current value */
+    int64_t periods = (total + (int64_t)(PERIOD_TICKS >> 1) - ll_now) /
+                      (int64_t)PERIOD_TICKS;
+    int64_t skew = total - periods * (int64_t)PERIOD_TICKS - ll_now;
+
+    /* if the low-level timer stopped in sleep (or drifted further than one
+     * RTT tick), shift xtimer's time base to the time told by the RTT */
+    if ((skew > (int64_t)RTT_TICK_TICKS) || (skew < -(int64_t)RTT_TICK_TICKS)) {
+        DEBUG("xtimer_tickless_idle(): shifting low-level timer by %" PRIi32
+              " ticks\n", (int32_t)skew);
+        _xtimer_lltimer_offset += (uint32_t)skew;
+        if ((int64_t)ll_now + skew < 0) {
+            periods--;
+        }
+        else if ((int64_t)ll_now + skew >= (int64_t)PERIOD_TICKS) {
+            periods++;
+        }
+    }
+    while (periods-- > 0) {
+        /* no timer is due before the deadline, so the current timer list
+         * is empty before each period */
+        _next_period();
+    }
+#ifdef MODULE_XTIMER_WAKEUPS
+    _wakeups.tickless++;
+#endif
+
+    if (timer_list_head) {
+        /* let the timer interrupt fire the timers that are due, callbacks
+         * must not run in the idle thread */
+        _lltimer_set(_xtimer_lltimer_now() + XTIMER_ISR_BACKOFF);
+    }
+    else {
+        _lltimer_set(0xFFFFFFFF);
+    }
+    irq_restore(state);
+}
+
+void kernel_idle(void)
+{
+    xtimer_tickless_idle();
+}
+#endif
+
+#ifdef MODULE_XTIMER_WAKEUPS
+void xtimer_wakeups_get(xtimer_wakeups_t *wakeups)
+{
+    unsigned state = irq_disable();
+
+    *wakeups = _wakeups;
+    irq_restore(state);
+}
+
+void xtimer_wakeups_reset(void)
+{
+    unsigned state = irq_disable();
+
+    memset(&_wakeups, 0, sizeof(_wakeups));
+    _wakeups.since = _xtimer_now64();
+    irq_restore(state);
+}
+
+uint32_t xtimer_wakeups_per_hour(const xtimer_wakeups_t *wakeups)
+{
+    uint64_t usec = _xtimer_usec_from_ticks64(_xtimer_now64() -
+                                              wakeups->since);
+    uint64_t sum = (uint64_t)wakeups->overflows + wakeups->timers +
+                   wakeups->tickless;
+
+    if (usec == 0) {
+        return 0;
+    }
+    return (uint32_t)((sum * 3600LU * US_PER_SEC) / usec);
+}
+#endif
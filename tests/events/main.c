@@ -18,6 +18,7 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "thread.h"
@@ -25,8 +26,17 @@
 #include "event/timeout.h"
 #include "event/callback.h"
 
+#ifndef BENCH_EVENTS
+#define BENCH_EVENTS    (32U)
+#endif
+
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS    (1024U)
+#endif
+
 static unsigned order;
 static uint32_t before;
+static event_t bench_events[BENCH_EVENTS];
 
 static void callback(event_t *arg);
 static void custom_callback(event_t *event);
@@ -85,10 +95,52 @@ static void forbidden_callback(void *arg)
     }
 }
 
+static void bench_handler(event_t *event)
+{
+    (void)event;
+}
+
+static void benchmark(void)
+{
+    event_queue_t queue;
+    event_t *batch[BENCH_EVENTS];
+    uint32_t post_usec = 0, drain_max = 0;
+
+    event_queue_init(&queue);
+    for (unsigned i = 0; i < BENCH_EVENTS; i++) {
+        bench_events[i].handler = bench_handler;
+    }
+    for (unsigned round = 0; round < BENCH_ROUNDS; round++) {
+        uint32_t start = xtimer_now_usec(), usec;
+
+        for (unsigned i = 0; i < BENCH_EVENTS; i++) {
+            event_post(&queue, &bench_events[i]);
+        }
+        post_usec += xtimer_now_usec() - start;
+        /* a batched drain runs with interrupts disabled */
+        start = xtimer_now_usec();
+        unsigned n = event_get_batch(&queue, batch, BENCH_EVENTS);
+        usec = xtimer_now_usec() - start;
+        drain_max = (usec > drain_max) ? usec : drain_max;
+        assert(n == BENCH_EVENTS);
+        for (unsigned i = 0; i < n; i++) {
+            assert(batch[i] == &bench_events[i]);
+            batch[i]->handler(batch[i]);
+        }
+    }
+    printf("benchmark: %" PRIu32 " posts/s, max IRQ-off time of batched drain "
+           "of %u events: %" PRIu32 " us\n",
+           (uint32_t)(((uint64_t)BENCH_EVENTS * BENCH_ROUNDS * US_PER_SEC) /
+                      (post_usec ? post_usec : 1)),
+           BENCH_EVENTS, drain_max);
+}
+
 int main(void)
 {
     puts("[START] event test application.\n");
 
+    benchmark();
+
     event_queue_t queue = { .waiter = (thread_t *)sched_active_thread };
     printf("posting 0x%08x\n", (unsigned)&event);
     event_post(&queue, &event);
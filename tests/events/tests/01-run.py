@@ -12,6 +12,8 @@ import sys
 
 
 def testfunc(child):
+    child.expect(r"benchmark: \d+ posts/s, max IRQ-off time of batched drain "
+                 r"of \d+ events: \d+ us")
     child.expect_exact(u"[SUCCESS]")
 
 
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Request rate of a gcoap server with many resources
+ *
+ * Registers @ref TEST_RESOURCES resources, checks which resource handles a few
+ * request paths and then sends @ref TEST_REQUESTS GET requests over the
+ * loopback interface, one after another and spread over all resources. Build
+ * with `TEST_INDEX=0` to compare against the linear resource search.
+ *
+ * The index only holds the sensor resources. The ones registered after them
+ * are found by the linear search the index falls back to, which must not
+ * rely on their order.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#ifndef TEST_RESOURCES
+#define TEST_RESOURCES      (256U)
+#endif
+
+#ifndef TEST_REQUESTS
+#define TEST_REQUESTS       (4096U)
+#endif
+
+#define TEST_PORT           (20000U)
+#define TEST_TIMEOUT        (US_PER_SEC)
+
+static ssize_t _sensor_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+static ssize_t _actuator_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+
+static char _paths[TEST_RESOURCES][sizeof("/sensor/0000")];
+static coap_resource_t _sensors[TEST_RESOURCES];
+static gcoap_listener_t _sensor_listener = {
+    &_sensors[0], TEST_RESOURCES, NULL
+};
+
+static coap_resource_t _actuators[] = {
+    { "/actuator", COAP_GET | COAP_PUT | GCOAP_MATCH_SUBTREE, _actuator_handler },
+};
+static gcoap_listener_t _actuator_listener = {
+    &_actuators[0], sizeof(_actuators) / sizeof(_actuators[0]), NULL
+};
+
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+/* out of alphabetical order, which only the index allows */
+static coap_resource_t _unsorted[] = {
+    { "/zone", COAP_GET, _actuator_handler },
+    { "/alarm", COAP_GET, _actuator_handler },
+};
+static gcoap_listener_t _unsorted_listener = {
+    &_unsorted[0], sizeof(_unsorted) / sizeof(_unsorted[0]), NULL
+};
+#endif
+
+static sock_udp_t _sock;
+static sock_udp_ep_t _server = {
+    .family = AF_INET6,
+    .netif = SOCK_ADDR_ANY_NETIF,
+    .port = GCOAP_PORT,
+};
+
+static ssize_t _sensor_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static ssize_t _actuator_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    return gcoap_response(pdu, buf, len, COAP_CODE_CHANGED);
+}
+
+/* sends a request and returns the raw response code, or -1 on error */
+static int _request(unsigned method, char *path)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    ssize_t len = gcoap_request(&pdu, buf, sizeof(buf), method, path);
+
+    if ((len <= 0) || (sock_udp_send(&_sock, buf, len, &_server) < 0)) {
+        return -1;
+    }
+    len = sock_udp_recv(&_sock, buf, sizeof(buf), TEST_TIMEOUT, NULL);
+    if ((len <= 0) || (coap_parse(&pdu, buf, len) < 0)) {
+        return -1;
+    }
+    return coap_get_code_raw(&pdu);
+}
+
+static int _expect(unsigned method, char *path, int code)
+{
+    int res = _request(method, path);
+
+    if (res != code) {
+        printf("%s: expected %d.%02d, got %d.%02d\n", path, code >> 5,
+               code & 0x1f, res >> 5, res & 0x1f);
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = {
+        .family = AF_INET6,
+        .netif = SOCK_ADDR_ANY_NETIF,
+        .port = TEST_PORT,
+    };
+
+    for (unsigned i = 0; i < TEST_RESOURCES; i++) {
+        snprintf(_paths[i], sizeof(_paths[i]), "/sensor/%04u", i);
+        _sensors[i].path = _paths[i];
+        _sensors[i].methods = COAP_GET;
+        _sensors[i].handler = _sensor_handler;
+    }
+    gcoap_register_listener(&_sensor_listener);
+    gcoap_register_listener(&_actuator_listener);
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+    gcoap_register_listener(&_unsorted_listener);
+#endif
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+    if (sock_udp_create(&_sock, &local, NULL, 0) < 0) {
+        puts("unable to create sock");
+        return 1;
+    }
+
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+    printf("Looking up %u resources with the index\n", TEST_RESOURCES);
+#else
+    printf("Looking up %u resources linearly\n", TEST_RESOURCES);
+#endif
+
+    if ((_expect(COAP_METHOD_GET, _paths[0], COAP_CODE_CONTENT) < 0) ||
+        (_expect(COAP_METHOD_GET, _paths[TEST_RESOURCES - 1],
+                 COAP_CODE_CONTENT) < 0) ||
+        (_expect(COAP_METHOD_GET, "/sensor", COAP_CODE_PATH_NOT_FOUND) < 0) ||
+        (_expect(COAP_METHOD_PUT, _paths[0], COAP_CODE_PATH_NOT_FOUND) < 0) ||
+        (_expect(COAP_METHOD_GET, "/actuator", COAP_CODE_CHANGED) < 0) ||
+        (_expect(COAP_METHOD_PUT, "/actuator/7/on", COAP_CODE_CHANGED) < 0) ||
+        (_expect(COAP_METHOD_POST, "/actuator/7", COAP_CODE_PATH_NOT_FOUND) < 0) ||
+        (_expect(COAP_METHOD_GET, "/actuators", COAP_CODE_PATH_NOT_FOUND) < 0)) {
+        return 1;
+    }
+#ifdef MODULE_GCOAP_RESOURCE_INDEX
+    if ((_expect(COAP_METHOD_GET, "/alarm", COAP_CODE_CHANGED) < 0) ||
+        (_expect(COAP_METHOD_GET, "/zone", COAP_CODE_CHANGED) < 0)) {
+        return 1;
+    }
+#endif
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_REQUESTS; i++) {
+        /* spread the requests over the resources */
+        char *path = _paths[(i * 7) % TEST_RESOURCES];
+
+        if (_expect(COAP_METHOD_GET, path, COAP_CODE_CONTENT) < 0) {
+            return 1;
+        }
+    }
+    uint32_t elapsed = xtimer_now_usec() - start;
+
+    printf("%u requests in %" PRIu32 " us: %" PRIu32 " requests/s\n",
+           TEST_REQUESTS, elapsed,
+           (uint32_t)(((uint64_t)TEST_REQUESTS * US_PER_SEC) / elapsed));
+    puts("SUCCESS");
+
+    return 0;
+}
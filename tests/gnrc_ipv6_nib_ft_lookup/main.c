@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for forwarding table lookups in the NIB
+ *
+ * Fills the forwarding table step by step with routes of different prefix
+ * lengths and measures the time a longest prefix match takes for each table
+ * size.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "xtimer.h"
+
+#ifndef TEST_ITERATIONS
+#define TEST_ITERATIONS     (10000U)
+#endif
+
+#define TEST_IFACE          (6U)
+
+static const ipv6_addr_t _next_hop = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+                                               0, 0, 0, 0, 0, 0, 0, 0x01 } };
+
+/* route i is 2001:db8:iXXX:XXXX::/(40 + (i % 4) * 8) */
+static void _route(unsigned i, ipv6_addr_t *addr, unsigned *pfx_len)
+{
+    uint32_t hash = (i + 1) * 2654435761U;
+
+    ipv6_addr_set_unspecified(addr);
+    addr->u8[0] = 0x20;
+    addr->u8[1] = 0x01;
+    addr->u8[2] = 0x0d;
+    addr->u8[3] = 0xb8;
+    addr->u8[4] = (uint8_t)i;
+    addr->u8[5] = (uint8_t)(hash >> 24);
+    addr->u8[6] = (uint8_t)(hash >> 16);
+    addr->u8[7] = (uint8_t)(hash >> 8);
+    *pfx_len = 40 + ((i % 4) * 8);
+}
+
+static int _bench(unsigned routes)
+{
+    uint32_t start, usec;
+    gnrc_ipv6_nib_ft_t fte;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+        unsigned pfx_len, route = i % routes;
+        ipv6_addr_t dst;
+
+        _route(route, &dst, &pfx_len);
+        dst.u8[15] = (uint8_t)i;
+        if ((gnrc_ipv6_nib_ft_get(&dst, NULL, &fte) != 0) ||
+            (fte.dst_len != pfx_len)) {
+            printf("error: wrong route for route %u\n", route);
+            return 1;
+        }
+    }
+    usec = xtimer_now_usec() - start;
+    printf("%3u routes: %" PRIu32 " us for %u lookups (%" PRIu32
+           " ns per lookup)\n", routes, usec, TEST_ITERATIONS,
+           (uint32_t)(((uint64_t)usec * 1000U) / TEST_ITERATIONS));
+    return 0;
+}
+
+int main(void)
+{
+    unsigned routes = 0;
+
+    printf("Benchmarking forwarding table lookups (%s)\n",
+           (GNRC_IPV6_NIB_CONF_OFFL_TRIE) ? "prefix trie" : "linear search");
+    for (unsigned step = 1; step <= GNRC_IPV6_NIB_OFFL_NUMOF; step *= 2) {
+        while (routes < step) {
+            unsigned pfx_len;
+            ipv6_addr_t dst;
+
+            _route(routes++, &dst, &pfx_len);
+            if (gnrc_ipv6_nib_ft_add(&dst, pfx_len, &_next_hop, TEST_IFACE,
+                                     0) != 0) {
+                puts("error: unable to add route");
+                puts("FAILURE");
+                return 1;
+            }
+        }
+        if (_bench(routes) != 0) {
+            puts("FAILURE");
+            return 1;
+        }
+    }
+    puts("SUCCESS");
+    return 0;
+}
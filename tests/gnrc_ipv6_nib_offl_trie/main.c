@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the NIB unit tests with GNRC_IPV6_NIB_CONF_OFFL_TRIE
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "xtimer.h"
+
+#include "tests-gnrc_ipv6_nib.h"
+
+int main(void)
+{
+    /* auto_init is disabled, but some modules depends on this module being
+     * initialized */
+    xtimer_init();
+
+    TESTS_START();
+    tests_gnrc_ipv6_nib();
+    TESTS_END();
+
+    return 0;
+}
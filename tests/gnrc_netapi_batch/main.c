@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for batched packet dispatch through gnrc_netapi
+ *
+ * Passes UDP datagrams to the IPv6 thread the way a network interface does
+ * and measures the time until all of them reached a receiver registered for
+ * their UDP port, once one packet per message and once in batches.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "mutex.h"
+#include "net/gnrc.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_BATCH_SIZE
+#define TEST_BATCH_SIZE     (16U)
+#endif
+
+#ifndef TEST_PAYLOAD_SIZE
+#define TEST_PAYLOAD_SIZE   (32U)
+#endif
+
+#ifndef TEST_ITERATIONS
+#define TEST_ITERATIONS     (TEST_BATCH_SIZE * 512U)
+#endif
+
+#define TEST_PORT           (0x2c94)
+#define RCV_MSG_QUEUE_SIZE  (8U)
+
+static uint8_t _datagram[sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t) +
+                         TEST_PAYLOAD_SIZE];
+static char _rcv_stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _done = MUTEX_INIT;
+static unsigned _received;
+
+static void _count(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktbuf_release(pkt);
+    if (++_received == TEST_ITERATIONS) {
+        mutex_unlock(&_done);
+    }
+}
+
+static void *_rcv_thread(void *arg)
+{
+    static gnrc_netapi_batch_t batch;
+    msg_t msg, msg_queue[RCV_MSG_QUEUE_SIZE];
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(TEST_PORT,
+                                                           sched_active_pid);
+
+    (void)arg;
+    msg_init_queue(msg_queue, RCV_MSG_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry);
+    gnrc_netapi_batch_enable(sched_active_pid);
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+                _count(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                gnrc_netapi_batch_handle(msg.content.ptr, _count, &batch);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+static void _init_datagram(void)
+{
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)_datagram;
+    udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+    uint8_t *payload = (uint8_t *)(udp + 1);
+    uint16_t len = sizeof(udp_hdr_t) + TEST_PAYLOAD_SIZE;
+    uint16_t csum;
+
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(len);
+    ipv6->nh = PROTNUM_UDP;
+    ipv6->hl = 64;
+    ipv6->src = ipv6_addr_loopback;
+    ipv6->dst = ipv6_addr_loopback;
+    udp->src_port = byteorder_htons(TEST_PORT);
+    udp->dst_port = byteorder_htons(TEST_PORT);
+    udp->length = byteorder_htons(len);
+    udp->checksum.u16 = 0;
+    for (unsigned i = 0; i < TEST_PAYLOAD_SIZE; i++) {
+        payload[i] = (uint8_t)i;
+    }
+    csum = inet_csum(0, (uint8_t *)udp, len);
+    csum = ~ipv6_hdr_inet_csum(csum, ipv6, PROTNUM_UDP, len);
+    udp->checksum = byteorder_htons((csum == 0) ? 0xffff : csum);
+}
+
+static bool _inject(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _datagram, sizeof(_datagram),
+                                          GNRC_NETTYPE_IPV6);
+
+    if (pkt == NULL) {
+        return false;
+    }
+    if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6,
+                                     GNRC_NETREG_DEMUX_CTX_ALL, pkt) == 0) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    return true;
+}
+
+static int _bench(const char *name, unsigned batch_size)
+{
+    uint32_t start, usec;
+    unsigned injected = 0;
+
+    _received = 0;
+    mutex_lock(&_done);
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_ITERATIONS; i += batch_size) {
+        static gnrc_netapi_batch_t batch;
+
+        if (batch_size > 1) {
+            gnrc_netapi_batch_begin(&batch);
+        }
+        for (unsigned j = 0; j < batch_size; j++) {
+            if (!_inject()) {
+                break;
+            }
+            injected++;
+        }
+        if (batch_size > 1) {
+            gnrc_netapi_batch_end(&batch);
+        }
+        if (injected < (i + batch_size)) {
+            puts("error: unable to inject datagram");
+            return 1;
+        }
+    }
+    /* wait for receiver to get the last datagram */
+    mutex_lock(&_done);
+    usec = xtimer_now_usec() - start;
+    mutex_unlock(&_done);
+    printf("%s: %" PRIu32 " us for %u datagrams (%" PRIu32 " datagrams/s)\n",
+           name, usec, TEST_ITERATIONS,
+           (uint32_t)(((uint64_t)TEST_ITERATIONS * US_PER_SEC) / usec));
+    return 0;
+}
+
+int main(void)
+{
+    _init_datagram();
+    if (thread_create(_rcv_stack, sizeof(_rcv_stack), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_STACKTEST, _rcv_thread, NULL, "rcv") <= 0) {
+        puts("error: unable to start receiver");
+        return 1;
+    }
+    printf("Benchmarking %u byte datagrams in batches of %u\n",
+           TEST_PAYLOAD_SIZE, TEST_BATCH_SIZE);
+    if ((_bench("unbatched", 1) != 0) ||
+        (_bench("batched", TEST_BATCH_SIZE) != 0)) {
+        puts("FAILURE");
+        return 1;
+    }
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Latency of the GNRC stack with and without direct call mode
+ *
+ * Passes UDP datagrams to IPv6 the way a network interface does and measures
+ * the time until each of them reached a receiver registered for its UDP port.
+ * Build with `TEST_DIRECT=0` to compare against IPv6 and UDP running in
+ * threads of their own.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "mutex.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/udp.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_PAYLOAD_SIZE
+#define TEST_PAYLOAD_SIZE   (32U)
+#endif
+
+#ifndef TEST_ITERATIONS
+#define TEST_ITERATIONS     (4096U)
+#endif
+
+#define TEST_PORT           (0x2c94)
+#define RCV_MSG_QUEUE_SIZE  (8U)
+
+/* RAM taken by the IPv6 and UDP threads when not in direct call mode */
+#define THREADS_RAM         (GNRC_IPV6_STACK_SIZE + GNRC_UDP_STACK_SIZE + \
+                             ((GNRC_IPV6_MSG_QUEUE_SIZE + \
+                               GNRC_UDP_MSG_QUEUE_SIZE) * sizeof(msg_t)))
+
+static uint8_t _datagram[sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t) +
+                         TEST_PAYLOAD_SIZE];
+static char _rcv_stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _done = MUTEX_INIT_LOCKED;
+
+static void *_rcv_thread(void *arg)
+{
+    msg_t msg, msg_queue[RCV_MSG_QUEUE_SIZE];
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(TEST_PORT,
+                                                           sched_active_pid);
+
+    (void)arg;
+    msg_init_queue(msg_queue, RCV_MSG_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry);
+    while (1) {
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+            mutex_unlock(&_done);
+        }
+    }
+    return NULL;
+}
+
+static void _init_datagram(void)
+{
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)_datagram;
+    udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+    uint8_t *payload = (uint8_t *)(udp + 1);
+    uint16_t len = sizeof(udp_hdr_t) + TEST_PAYLOAD_SIZE;
+    uint16_t csum;
+
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(len);
+    ipv6->nh = PROTNUM_UDP;
+    ipv6->hl = 64;
+    ipv6->src = ipv6_addr_loopback;
+    ipv6->dst = ipv6_addr_loopback;
+    udp->src_port = byteorder_htons(TEST_PORT);
+    udp->dst_port = byteorder_htons(TEST_PORT);
+    udp->length = byteorder_htons(len);
+    udp->checksum.u16 = 0;
+    for (unsigned i = 0; i < TEST_PAYLOAD_SIZE; i++) {
+        payload[i] = (uint8_t)i;
+    }
+    csum = inet_csum(0, (uint8_t *)udp, len);
+    csum = ~ipv6_hdr_inet_csum(csum, ipv6, PROTNUM_UDP, len);
+    udp->checksum = byteorder_htons((csum == 0) ? 0xffff : csum);
+}
+
+static bool _inject(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _datagram, sizeof(_datagram),
+                                          GNRC_NETTYPE_IPV6);
+
+    if (pkt == NULL) {
+        return false;
+    }
+    if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6,
+                                     GNRC_NETREG_DEMUX_CTX_ALL, pkt) == 0) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    uint32_t min = UINT32_MAX, max = 0;
+    uint64_t sum = 0;
+
+    _init_datagram();
+    if (thread_create(_rcv_stack, sizeof(_rcv_stack), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_STACKTEST, _rcv_thread, NULL, "rcv") <= 0) {
+        puts("error: unable to start receiver");
+        return 1;
+    }
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    printf("Stack runs directly, %u bytes of thread stacks and message queues "
+           "saved\n", (unsigned)THREADS_RAM);
+#else
+    printf("Stack runs in threads, %u bytes of thread stacks and message "
+           "queues used\n", (unsigned)THREADS_RAM);
+#endif
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+        uint32_t start = xtimer_now_usec(), usec;
+
+        if (!_inject()) {
+            puts("error: unable to inject datagram");
+            puts("FAILURE");
+            return 1;
+        }
+        /* wait for receiver to get the datagram */
+        mutex_lock(&_done);
+        usec = xtimer_now_usec() - start;
+        min = (usec < min) ? usec : min;
+        max = (usec > max) ? usec : max;
+        sum += usec;
+    }
+    printf("latency: min %" PRIu32 " us, avg %" PRIu32 " us, max %" PRIu32
+           " us for %u datagrams\n", min, (uint32_t)(sum / TEST_ITERATIONS),
+           max, TEST_ITERATIONS);
+    puts("SUCCESS");
+    return 0;
+}
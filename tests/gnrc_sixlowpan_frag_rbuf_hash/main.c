@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the hash indexed 6LoWPAN reassembly buffer
+ *
+ * Fragments of uncompressed datagrams are injected as if received from a
+ * neighbor. After each case, the reassembled datagrams handed to the IPv6
+ * layer and the counters of the reassembly buffer are checked.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
+
+#define TEST_DATAGRAM_SIZE  (200U)
+/* bytes of the datagram per fragment, a multiple of 8 */
+#define TEST_FRAG_SIZE      (64U)
+/* larger than GNRC_PKTBUF_SIZE in the Makefile */
+#define TEST_OVERSIZED      (2040U)
+#define TEST_TIMEOUT        (100U * US_PER_MS)
+#define TEST_QUEUE_SIZE     (8U)
+
+static uint8_t _own_l2addr[] = { 0x02, 0x00, 0x00, 0xff,
+                                 0xfe, 0x00, 0x00, 0x02 };
+static uint8_t _prev_l2addr[] = { 0x02, 0x00, 0x00, 0xff,
+                                  0xfe, 0x00, 0x00, 0x01 };
+
+static netdev_test_t _netdev;
+static gnrc_netif_t *_netif;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _msg_queue[TEST_QUEUE_SIZE];
+static uint8_t _datagram[TEST_DATAGRAM_SIZE];
+static gnrc_sixlowpan_frag_rbuf_stats_t _expected;
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_own_l2addr);
+    return sizeof(uint16_t);
+}
+
+static int _get_address_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len >= sizeof(_own_l2addr));
+    memcpy(value, _own_l2addr, sizeof(_own_l2addr));
+    return sizeof(_own_l2addr);
+}
+
+static int _init_netif(void)
+{
+    netdev_test_setup(&_netdev, 0);
+    netdev_test_set_get_cb(&_netdev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_netdev, NETOPT_SRC_LEN, _get_src_len);
+    netdev_test_set_get_cb(&_netdev, NETOPT_ADDRESS_LONG, _get_address_long);
+    _netif = gnrc_netif_ieee802154_create(_netif_stack, sizeof(_netif_stack),
+                                          GNRC_NETIF_PRIO, "wpan",
+                                          &_netdev.netdev.netdev);
+    return (_netif == NULL) ? -1 : 0;
+}
+
+/* link-local multicast datagram without upper layer, the IPv6 layer drops
+ * it after the test received its copy */
+static void _init_datagram(void)
+{
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)_datagram;
+    uint8_t *payload = (uint8_t *)(ipv6 + 1);
+
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(TEST_DATAGRAM_SIZE - sizeof(ipv6_hdr_t));
+    ipv6->nh = PROTNUM_IPV6_NONXT;
+    ipv6->hl = 64;
+    ipv6_addr_set_link_local_prefix(&ipv6->src);
+    ipv6->src.u8[15] = 1;
+    ipv6_addr_set_all_nodes_multicast(&ipv6->dst, IPV6_ADDR_MCAST_SCP_LINK_LOCAL);
+    for (unsigned i = 0; i < (TEST_DATAGRAM_SIZE - sizeof(ipv6_hdr_t)); i++) {
+        payload[i] = (uint8_t)i;
+    }
+}
+
+static bool _inject(const void *hdr, size_t hdr_len, const uint8_t *data,
+                    size_t data_len)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, hdr_len + data_len,
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(_prev_l2addr,
+                                                 sizeof(_prev_l2addr),
+                                                 _own_l2addr,
+                                                 sizeof(_own_l2addr));
+
+    if ((pkt == NULL) || (netif == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _netif->pid;
+    memcpy(pkt->data, hdr, hdr_len);
+    memcpy(((uint8_t *)pkt->data) + hdr_len, data, data_len);
+    pkt->next = netif;
+    /* the 6LoWPAN thread has a higher priority, so the fragment is handled
+     * when this returns */
+    if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN,
+                                     GNRC_NETREG_DEMUX_CTX_ALL, pkt) == 0) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    return true;
+}
+
+/* injects the first fragment, with an uncompressed IPv6 header */
+static bool _frag_1(uint16_t tag, uint16_t size)
+{
+    uint8_t data[1 + TEST_FRAG_SIZE];
+    sixlowpan_frag_t hdr;
+
+    hdr.disp_size = byteorder_htons(size);
+    hdr.disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    hdr.tag = byteorder_htons(tag);
+    data[0] = SIXLOWPAN_UNCOMP;
+    memcpy(&data[1], _datagram, TEST_FRAG_SIZE);
+    return _inject(&hdr, sizeof(hdr), data, sizeof(data));
+}
+
+/* injects a subsequent fragment of up to TEST_FRAG_SIZE bytes */
+static bool _frag_n(uint16_t tag, size_t offset)
+{
+    size_t len = TEST_DATAGRAM_SIZE - offset;
+    sixlowpan_frag_n_t hdr;
+
+    hdr.disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+    hdr.disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+    hdr.tag = byteorder_htons(tag);
+    hdr.offset = offset / 8;
+    return _inject(&hdr, sizeof(hdr), &_datagram[offset],
+                   (len < TEST_FRAG_SIZE) ? len : TEST_FRAG_SIZE);
+}
+
+/* injects all subsequent fragments of a datagram */
+static bool _frag_rest(uint16_t tag)
+{
+    for (size_t offset = TEST_FRAG_SIZE; offset < TEST_DATAGRAM_SIZE;
+         offset += TEST_FRAG_SIZE) {
+        if (!_frag_n(tag, offset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* checks if the reassembled datagram was delivered, or that none was */
+static bool _delivered(bool expected)
+{
+    msg_t msg;
+    gnrc_pktsnip_t *pkt;
+    bool ok;
+
+    if (xtimer_msg_receive_timeout(&msg, TEST_TIMEOUT) < 0) {
+        if (expected) {
+            puts("error: datagram was not reassembled");
+        }
+        return !expected;
+    }
+    assert(msg.type == GNRC_NETAPI_MSG_TYPE_RCV);
+    pkt = msg.content.ptr;
+    ok = expected && (pkt->size == TEST_DATAGRAM_SIZE) &&
+         (memcmp(pkt->data, _datagram, TEST_DATAGRAM_SIZE) == 0);
+    if (!ok) {
+        puts("error: unexpected datagram");
+    }
+    gnrc_pktbuf_release(pkt);
+    return ok;
+}
+
+static bool _check_stats(void)
+{
+    gnrc_sixlowpan_frag_rbuf_stats_t stats;
+
+    gnrc_sixlowpan_frag_rbuf_get_stats(&stats);
+    if (memcmp(&stats, &_expected, sizeof(stats)) != 0) {
+        printf("error: expected %" PRIu32 " datagrams, %" PRIu32 " timeouts, %"
+               PRIu32 " overlaps, %" PRIu32 " evictions\n",
+               _expected.datagrams, _expected.timeouts, _expected.overlaps,
+               _expected.evictions);
+        printf("       got %" PRIu32 " datagrams, %" PRIu32 " timeouts, %"
+               PRIu32 " overlaps, %" PRIu32 " evictions\n",
+               stats.datagrams, stats.timeouts, stats.overlaps,
+               stats.evictions);
+        return false;
+    }
+    return true;
+}
+
+static bool test_in_order(void)
+{
+    if (!_frag_1(1, TEST_DATAGRAM_SIZE) || !_frag_rest(1) || !_delivered(true)) {
+        return false;
+    }
+    _expected.datagrams++;
+    return _check_stats();
+}
+
+static bool test_out_of_order(void)
+{
+    size_t offset = ((TEST_DATAGRAM_SIZE - 1) / TEST_FRAG_SIZE) * TEST_FRAG_SIZE;
+
+    for (; offset > 0; offset -= TEST_FRAG_SIZE) {
+        if (!_frag_n(2, offset)) {
+            return false;
+        }
+    }
+    if (!_frag_1(2, TEST_DATAGRAM_SIZE) || !_delivered(true)) {
+        return false;
+    }
+    _expected.datagrams++;
+    return _check_stats();
+}
+
+static bool test_duplicate(void)
+{
+    /* the second copy of the fragment is ignored, the datagram is complete
+     * and delivered once */
+    if (!_frag_1(3, TEST_DATAGRAM_SIZE) || !_frag_n(3, TEST_FRAG_SIZE) ||
+        !_frag_rest(3) || !_delivered(true) || !_delivered(false)) {
+        return false;
+    }
+    _expected.datagrams++;
+    return _check_stats();
+}
+
+static bool test_overlap(void)
+{
+    /* overlaps the second half of the first fragment: reassembly restarts
+     * with it, so the datagram stays incomplete */
+    if (!_frag_1(4, TEST_DATAGRAM_SIZE) ||
+        !_frag_n(4, TEST_FRAG_SIZE / 2) || !_delivered(false)) {
+        return false;
+    }
+    _expected.overlaps++;
+    return _check_stats();
+}
+
+static bool test_timeout(void)
+{
+    /* the incomplete datagram of test_overlap() times out with the next
+     * fragment */
+    xtimer_usleep(RBUF_TIMEOUT + TEST_TIMEOUT);
+    if (!_frag_1(5, TEST_DATAGRAM_SIZE)) {
+        return false;
+    }
+    _expected.timeouts++;
+    if (!_check_stats() || !_frag_rest(5) || !_delivered(true)) {
+        return false;
+    }
+    _expected.datagrams++;
+    return _check_stats();
+}
+
+static bool test_eviction(void)
+{
+    /* one datagram more than fit: the oldest one is evicted */
+    for (uint16_t tag = 10; tag <= (10 + RBUF_SIZE); tag++) {
+        if (!_frag_1(tag, TEST_DATAGRAM_SIZE)) {
+            return false;
+        }
+    }
+    _expected.evictions++;
+    if (!_check_stats() || !_frag_rest(11) || !_delivered(true)) {
+        return false;
+    }
+    _expected.datagrams++;
+    return _check_stats();
+}
+
+static bool test_oversized(void)
+{
+    /* a datagram that can never fit the packet buffer does not evict the
+     * incomplete ones of test_eviction() */
+    if (!_frag_1(20, TEST_OVERSIZED) || !_check_stats() ||
+        !_frag_rest(12) || !_delivered(true)) {
+        return false;
+    }
+    _expected.datagrams++;
+    return _check_stats();
+}
+
+static void _run(const char *name, bool (*test)(void), bool *ok)
+{
+    if (*ok) {
+        *ok = test();
+        printf("%s: %s\n", name, (*ok) ? "OK" : "FAILED");
+    }
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t ipv6 = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                          sched_active_pid);
+    bool ok = true;
+
+    msg_init_queue(_msg_queue, TEST_QUEUE_SIZE);
+    if (_init_netif() < 0) {
+        puts("error: unable to initialize test");
+        return 1;
+    }
+    _init_datagram();
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &ipv6);
+
+    _run("in order", test_in_order, &ok);
+    _run("out of order", test_out_of_order, &ok);
+    _run("duplicate", test_duplicate, &ok);
+    _run("overlap", test_overlap, &ok);
+    _run("timeout", test_timeout, &ok);
+    _run("eviction", test_eviction, &ok);
+    _run("oversized datagram", test_oversized, &ok);
+    puts(ok ? "SUCCESS" : "FAILURE");
+    return (ok) ? 0 : 1;
+}
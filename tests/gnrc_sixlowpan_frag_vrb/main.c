@@ -0,0 +1,343 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Latency and buffer usage of a 6LoWPAN router forwarding
+ *              fragmented datagrams
+ *
+ * The node is the middle hop of a three hop path: fragments of a UDP datagram
+ * are received from a previous hop one per @ref TEST_AIRTIME_US and every frame
+ * sent to the next hop takes @ref TEST_AIRTIME_US as well. The latency is
+ * measured from the arrival of the first fragment until the last fragment was
+ * sent on. Build with `TEST_VRB=0` to compare against reassembling each
+ * datagram before forwarding it.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "mutex.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ieee802154.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "xtimer.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
+
+#ifndef TEST_DATAGRAM_SIZE
+#define TEST_DATAGRAM_SIZE  (1024U)
+#endif
+
+#ifndef TEST_ITERATIONS
+#define TEST_ITERATIONS     (32U)
+#endif
+
+#ifndef TEST_AIRTIME_US
+#define TEST_AIRTIME_US     (4000U)
+#endif
+
+/* bytes of the uncompressed datagram per fragment, a multiple of 8 */
+#define TEST_FRAG_SIZE      (64U)
+#define TEST_MAX_FRAME_SIZE (102U)
+#define TEST_TIMEOUT        (US_PER_SEC)
+
+#define TEST_PAYLOAD_SIZE   (TEST_DATAGRAM_SIZE - sizeof(ipv6_hdr_t) - \
+                             sizeof(udp_hdr_t))
+
+static uint8_t _own_l2addr[] = { 0x02, 0x00, 0x00, 0xff,
+                                 0xfe, 0x00, 0x00, 0x02 };
+static uint8_t _prev_l2addr[] = { 0x02, 0x00, 0x00, 0xff,
+                                  0xfe, 0x00, 0x00, 0x01 };
+static uint8_t _next_l2addr[] = { 0x02, 0x00, 0x00, 0xff,
+                                 0xfe, 0x00, 0x00, 0x03 };
+
+static netdev_test_t _netdev;
+static gnrc_netif_t *_netif;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _datagram[TEST_DATAGRAM_SIZE];
+static uint8_t _comp[TEST_DATAGRAM_SIZE];
+static size_t _comp_len;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = TEST_MAX_FRAME_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_own_l2addr);
+    return sizeof(uint16_t);
+}
+
+static int _get_address_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len >= sizeof(_own_l2addr));
+    memcpy(value, _own_l2addr, sizeof(_own_l2addr));
+    return sizeof(_own_l2addr);
+}
+
+static int _send(netdev_t *dev, const struct iovec *vector, int count)
+{
+    uint8_t frame[IEEE802154_FRAME_LEN_MAX];
+    sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)frame;
+    size_t len = 0;
+
+    (void)dev;
+    /* vector[0] is the MAC header */
+    for (int i = 1; i < count; i++) {
+        if ((len + vector[i].iov_len) > sizeof(frame)) {
+            return -EMSGSIZE;
+        }
+        memcpy(&frame[len], vector[i].iov_base, vector[i].iov_len);
+        len += vector[i].iov_len;
+    }
+    xtimer_usleep(TEST_AIRTIME_US);
+    if ((len > sizeof(sixlowpan_frag_n_t)) &&
+        ((frame[0] & SIXLOWPAN_FRAG_DISP_MASK) == SIXLOWPAN_FRAG_N_DISP) &&
+        (((hdr->offset * 8U) + len - sizeof(sixlowpan_frag_n_t)) >=
+         TEST_DATAGRAM_SIZE)) {
+        /* last fragment of the datagram */
+        mutex_unlock(&_done);
+    }
+    return (int)(len + vector[0].iov_len);
+}
+
+static int _init_netif(void)
+{
+    ipv6_addr_t next = { .u8 = { 0xfd, 0x01 } };
+
+    netdev_test_setup(&_netdev, 0);
+    netdev_test_set_get_cb(&_netdev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_netdev, NETOPT_MAX_PACKET_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_netdev, NETOPT_SRC_LEN, _get_src_len);
+    netdev_test_set_get_cb(&_netdev, NETOPT_ADDRESS_LONG, _get_address_long);
+    netdev_test_set_send_cb(&_netdev, _send);
+    _netif = gnrc_netif_ieee802154_create(_netif_stack, sizeof(_netif_stack),
+                                          GNRC_NETIF_PRIO, "wpan",
+                                          &_netdev.netdev.netdev);
+    if (_netif == NULL) {
+        return -1;
+    }
+    /* fd01::3 is the next hop */
+    next.u8[15] = 3;
+    return gnrc_ipv6_nib_nc_set(&next, _netif->pid, _next_l2addr,
+                                sizeof(_next_l2addr));
+}
+
+static gnrc_pktsnip_t *_netif_hdr(void)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(_prev_l2addr,
+                                                 sizeof(_prev_l2addr),
+                                                 _own_l2addr,
+                                                 sizeof(_own_l2addr));
+
+    if (netif != NULL) {
+        ((gnrc_netif_hdr_t *)netif->data)->if_pid = _netif->pid;
+    }
+    return netif;
+}
+
+/* builds the datagram as the previous hop sends it, compressed for the
+ * link to this node */
+static int _init_datagram(void)
+{
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)_datagram;
+    udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+    uint8_t *payload = (uint8_t *)(udp + 1);
+    uint16_t len = sizeof(udp_hdr_t) + TEST_PAYLOAD_SIZE;
+    gnrc_pktsnip_t *pkt, *ipv6_snip, *netif;
+    uint16_t csum;
+
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(len);
+    ipv6->nh = PROTNUM_UDP;
+    ipv6->hl = 64;
+    ipv6->src.u8[0] = 0xfd;
+    ipv6->src.u8[1] = 0x01;
+    ipv6->src.u8[15] = 1;
+    ipv6->dst.u8[0] = 0xfd;
+    ipv6->dst.u8[1] = 0x01;
+    ipv6->dst.u8[15] = 3;
+    udp->src_port = byteorder_htons(0xf0b1);
+    udp->dst_port = byteorder_htons(0xf0b3);
+    udp->length = byteorder_htons(len);
+    udp->checksum.u16 = 0;
+    for (unsigned i = 0; i < TEST_PAYLOAD_SIZE; i++) {
+        payload[i] = (uint8_t)i;
+    }
+    csum = inet_csum(0, (uint8_t *)udp, len);
+    csum = ~ipv6_hdr_inet_csum(csum, ipv6, PROTNUM_UDP, len);
+    udp->checksum = byteorder_htons((csum == 0) ? 0xffff : csum);
+
+    pkt = gnrc_pktbuf_add(NULL, udp, len, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return -1;
+    }
+    ipv6_snip = gnrc_pktbuf_add(pkt, ipv6, sizeof(ipv6_hdr_t),
+                                GNRC_NETTYPE_IPV6);
+    if ((ipv6_snip == NULL) || ((netif = _netif_hdr()) == NULL)) {
+        gnrc_pktbuf_release((ipv6_snip == NULL) ? pkt : ipv6_snip);
+        return -1;
+    }
+    netif->next = ipv6_snip;
+    if (!gnrc_sixlowpan_iphc_encode(netif)) {
+        gnrc_pktbuf_release(netif);
+        return -1;
+    }
+    _comp_len = 0;
+    for (pkt = netif->next; pkt != NULL; pkt = pkt->next) {
+        memcpy(&_comp[_comp_len], pkt->data, pkt->size);
+        _comp_len += pkt->size;
+    }
+    gnrc_pktbuf_release(netif);
+    return 0;
+}
+
+static bool _inject(const void *hdr, size_t hdr_len, const uint8_t *data,
+                    size_t data_len)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, hdr_len + data_len,
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *netif = _netif_hdr();
+
+    if ((pkt == NULL) || (netif == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    memcpy(pkt->data, hdr, hdr_len);
+    memcpy(((uint8_t *)pkt->data) + hdr_len, data, data_len);
+    pkt->next = netif;
+    if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN,
+                                     GNRC_NETREG_DEMUX_CTX_ALL, pkt) == 0) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    return true;
+}
+
+/* receives all fragments of one datagram, one per airtime */
+static bool _receive_datagram(uint16_t tag)
+{
+    /* bytes the header compression saved, all in the first fragment */
+    size_t diff = TEST_DATAGRAM_SIZE - _comp_len;
+    sixlowpan_frag_n_t hdr;
+
+    hdr.disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+    hdr.disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    hdr.tag = byteorder_htons(tag);
+    if (!_inject(&hdr, sizeof(sixlowpan_frag_t), _comp,
+                 TEST_FRAG_SIZE - diff)) {
+        return false;
+    }
+    hdr.disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+    hdr.disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+    for (size_t offset = TEST_FRAG_SIZE; offset < TEST_DATAGRAM_SIZE;
+         offset += TEST_FRAG_SIZE) {
+        size_t len = TEST_DATAGRAM_SIZE - offset;
+
+        xtimer_usleep(TEST_AIRTIME_US);
+        hdr.offset = offset / 8;
+        if (!_inject(&hdr, sizeof(hdr), &_comp[offset - diff],
+                     (len < TEST_FRAG_SIZE) ? len : TEST_FRAG_SIZE)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(void)
+{
+    uint32_t min = UINT32_MAX, max = 0;
+    uint64_t sum = 0;
+    gnrc_pktbuf_stats_t stats;
+
+    if ((_init_netif() < 0) || (_init_datagram() < 0)) {
+        puts("error: unable to initialize test");
+        return 1;
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    printf("Forwarding %u byte datagrams fragment by fragment\n",
+           TEST_DATAGRAM_SIZE);
+#else
+    printf("Forwarding %u byte datagrams after reassembly\n",
+           TEST_DATAGRAM_SIZE);
+#endif
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+        uint32_t start = xtimer_now_usec(), usec;
+
+        if (!_receive_datagram(i)) {
+            puts("error: unable to inject fragments");
+            puts("FAILURE");
+            return 1;
+        }
+        if (xtimer_mutex_lock_timeout(&_done, TEST_TIMEOUT) < 0) {
+            puts("error: datagram was not forwarded");
+            puts("FAILURE");
+            return 1;
+        }
+        usec = xtimer_now_usec() - start;
+        min = (usec < min) ? usec : min;
+        max = (usec > max) ? usec : max;
+        sum += usec;
+    }
+    printf("latency: min %" PRIu32 " us, avg %" PRIu32 " us, max %" PRIu32
+           " us for %u datagrams\n", min, (uint32_t)(sum / TEST_ITERATIONS),
+           max, TEST_ITERATIONS);
+    gnrc_pktbuf_get_stats(&stats);
+    printf("packet buffer: %u bytes used at most\n", (unsigned)stats.used_peak);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_stats_t vrb_stats;
+
+    gnrc_sixlowpan_frag_vrb_get_stats(&vrb_stats);
+    printf("VRB: %" PRIu32 " datagrams, %" PRIu32 " fragments, %" PRIu32
+           " reassembled since full, %" PRIu32 " timed out\n",
+           vrb_stats.datagrams, vrb_stats.fragments, vrb_stats.full,
+           vrb_stats.timeouts);
+    if ((vrb_stats.datagrams != TEST_ITERATIONS) || (vrb_stats.full != 0)) {
+        puts("error: datagrams were not forwarded fragment by fragment");
+        puts("FAILURE");
+        return 1;
+    }
+#endif
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,32 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect(r"Forwarding \d+ byte datagrams (fragment by fragment|"
+                 r"after reassembly)")
+    vrb = (child.match.group(1) == "fragment by fragment")
+    child.expect(r"latency: min \d+ us, avg \d+ us, max \d+ us "
+                 r"for (\d+) datagrams")
+    datagrams = int(child.match.group(1))
+    child.expect(r"packet buffer: \d+ bytes used at most")
+    if vrb:
+        child.expect(r"VRB: (\d+) datagrams, \d+ fragments, (\d+) "
+                     r"reassembled since full, \d+ timed out")
+        assert int(child.match.group(1)) == datagrams
+        assert int(child.match.group(2)) == 0
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=120))
@@ -587,6 +587,24 @@ static void test_sock_ip_send__no_sock(void)
     assert(_check_net());
 }
 
+static void test_sock_ip_sendv__no_sock(void)
+{
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_ip_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF };
+    const struct iovec vector[] = { { .iov_base = "AB", .iov_len = 2 },
+                                    { .iov_base = NULL, .iov_len = 0 },
+                                    { .iov_base = "CD", .iov_len = sizeof("CD") } };
+
+    assert(sizeof("ABCD") == sock_ip_sendv(NULL, vector, 3, _TEST_PROTO,
+                                           &remote));
+    assert(_check_packet(&ipv6_addr_unspecified, &dst_addr, _TEST_PROTO, "ABCD",
+                         sizeof("ABCD"), _TEST_NETIF));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -632,6 +650,7 @@ int main(void)
     CALL(test_sock_ip_send__unsocketed());
     CALL(test_sock_ip_send__no_sock_no_netif());
     CALL(test_sock_ip_send__no_sock());
+    CALL(test_sock_ip_sendv__no_sock());
 
     puts("ALL TESTS SUCCESSFUL");
 
@@ -45,6 +45,7 @@ def testfunc(child):
     child.expect_exact(u"Calling test_sock_ip_send__unsocketed()")
     child.expect_exact(u"Calling test_sock_ip_send__no_sock_no_netif()")
     child.expect_exact(u"Calling test_sock_ip_send__no_sock()")
+    child.expect_exact(u"Calling test_sock_ip_sendv__no_sock()")
     child.expect_exact(u"ALL TESTS SUCCESSFUL")
 
 
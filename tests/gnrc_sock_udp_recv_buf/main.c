@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for sock_udp_recv() against sock_udp_recv_buf()
+ *
+ * Injects UDP datagrams directly into the sock and measures the time needed
+ * to receive and read them, once copied into an application buffer and once
+ * read directly from the packet buffer.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "byteorder.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/sock/udp.h"
+#include "net/udp.h"
+#include "xtimer.h"
+
+#ifndef TEST_PAYLOAD_SIZE
+#define TEST_PAYLOAD_SIZE   (1024U)
+#endif
+
+#ifndef TEST_ITERATIONS
+#define TEST_ITERATIONS     (10000U)
+#endif
+
+#define TEST_PORT_LOCAL     (0x2c94)
+#define TEST_PORT_REMOTE    (0xa615)
+
+static const ipv6_addr_t _src = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+                                          0, 0, 0, 0, 0, 0, 0, 0x01 } };
+static const ipv6_addr_t _dst = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+                                          0, 0, 0, 0, 0, 0, 0, 0x02 } };
+
+static uint8_t _payload[TEST_PAYLOAD_SIZE];
+static uint8_t _recv_buffer[TEST_PAYLOAD_SIZE];
+static sock_udp_t _sock;
+
+static bool _inject(void)
+{
+    gnrc_pktsnip_t *pkt, *udp, *ipv6, *netif;
+    udp_hdr_t *hdr;
+
+    udp = gnrc_pktbuf_add(NULL, NULL, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP);
+    if (udp == NULL) {
+        return false;
+    }
+    hdr = udp->data;
+    hdr->src_port = byteorder_htons(TEST_PORT_REMOTE);
+    hdr->dst_port = byteorder_htons(TEST_PORT_LOCAL);
+    hdr->length = byteorder_htons(sizeof(udp_hdr_t) + sizeof(_payload));
+    hdr->checksum.u16 = 0;
+    pkt = gnrc_pktbuf_add(udp, _payload, sizeof(_payload), GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(udp);
+        return false;
+    }
+    ipv6 = gnrc_ipv6_hdr_build(NULL, &_src, &_dst);
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if ((ipv6 == NULL) || (netif == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        gnrc_pktbuf_release(ipv6);
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    LL_APPEND(pkt, ipv6);
+    LL_APPEND(pkt, netif);
+    return (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, TEST_PORT_LOCAL,
+                                         pkt) > 0);
+}
+
+static uint32_t _consume(const uint8_t *data, size_t len)
+{
+    uint32_t sum = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+static void _print_result(const char *name, uint32_t usec, uint32_t copied)
+{
+    printf("%s: %" PRIu32 " us for %u datagrams (%" PRIu32 " ns per datagram), "
+           "%" PRIu32 " bytes copied\n", name, usec, TEST_ITERATIONS,
+           (uint32_t)(((uint64_t)usec * 1000U) / TEST_ITERATIONS), copied);
+}
+
+static int _bench_recv(void)
+{
+    uint32_t usec = 0, copied = 0, sum = 0;
+
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+        uint32_t start;
+        ssize_t res;
+
+        if (!_inject()) {
+            puts("error: unable to inject datagram");
+            return 1;
+        }
+        start = xtimer_now_usec();
+        res = sock_udp_recv(&_sock, _recv_buffer, sizeof(_recv_buffer), 0,
+                            NULL);
+        if (res != (ssize_t)sizeof(_payload)) {
+            printf("error: sock_udp_recv() returned %d\n", (int)res);
+            return 1;
+        }
+        sum += _consume(_recv_buffer, res);
+        usec += xtimer_now_usec() - start;
+        copied += res;
+    }
+    _print_result("sock_udp_recv", usec, copied);
+    return (sum == (TEST_ITERATIONS * _consume(_payload, sizeof(_payload))))
+           ? 0 : 1;
+}
+
+static int _bench_recv_buf(void)
+{
+    uint32_t usec = 0, sum = 0;
+
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+        uint32_t start;
+        void *data, *ctx;
+        ssize_t res;
+
+        if (!_inject()) {
+            puts("error: unable to inject datagram");
+            return 1;
+        }
+        start = xtimer_now_usec();
+        res = sock_udp_recv_buf(&_sock, &data, &ctx, 0, NULL);
+        if (res != (ssize_t)sizeof(_payload)) {
+            printf("error: sock_udp_recv_buf() returned %d\n", (int)res);
+            return 1;
+        }
+        sum += _consume(data, res);
+        sock_udp_recv_buf_free(ctx);
+        usec += xtimer_now_usec() - start;
+    }
+    _print_result("sock_udp_recv_buf", usec, 0);
+    return (sum == (TEST_ITERATIONS * _consume(_payload, sizeof(_payload))))
+           ? 0 : 1;
+}
+
+int main(void)
+{
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = TEST_PORT_LOCAL };
+
+    for (unsigned i = 0; i < sizeof(_payload); i++) {
+        _payload[i] = (uint8_t)i;
+    }
+    if (sock_udp_create(&_sock, &local, NULL, 0) < 0) {
+        puts("error: unable to create sock");
+        return 1;
+    }
+    printf("Benchmarking %u byte datagrams\n", (unsigned)sizeof(_payload));
+    if ((_bench_recv() != 0) || (_bench_recv_buf() != 0)) {
+        puts("FAILURE");
+        return 1;
+    }
+    puts("SUCCESS");
+    return 0;
+}
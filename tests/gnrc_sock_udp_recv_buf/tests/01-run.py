@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect(r"sock_udp_recv: \d+ us for \d+ datagrams \(\d+ ns per datagram\), "
+                 r"\d+ bytes copied")
+    child.expect(r"sock_udp_recv_buf: \d+ us for \d+ datagrams \(\d+ ns per datagram\), "
+                 r"0 bytes copied")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=60))
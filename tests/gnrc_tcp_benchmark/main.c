@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of GNRC TCP depending on the round trip time
+ *
+ * Sends data to a sink on the host, see README.md for adding delay to the
+ * link. Build with `TCP_RETRANSMIT_QUEUE_SIZE=1` to compare against a
+ * stop-and-wait sender.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+#define CHUNK_SIZE  (1024U)
+
+static uint8_t _buf[CHUNK_SIZE];
+
+static int _run(const ipv6_addr_t *addr)
+{
+    gnrc_tcp_tcb_t tcb;
+    uint32_t start, usec;
+    size_t sent = 0;
+    int ret;
+
+    gnrc_tcp_tcb_init(&tcb);
+    ret = gnrc_tcp_open_active(&tcb, AF_INET6, (uint8_t *)addr, TARGET_PORT, 0);
+    if (ret < 0) {
+        printf("error: unable to connect (%d)\n", ret);
+        return ret;
+    }
+    start = xtimer_now_usec();
+    while (sent < TEST_BYTES) {
+        size_t len = TEST_BYTES - sent;
+
+        len = (len < sizeof(_buf)) ? len : sizeof(_buf);
+        ret = gnrc_tcp_send(&tcb, _buf, len, 0);
+        if (ret < 0) {
+            printf("error: unable to send (%d)\n", ret);
+            gnrc_tcp_abort(&tcb);
+            return ret;
+        }
+        sent += ret;
+    }
+    /* wait for the peer to acknowledge everything, a reset clears the queue */
+    while (tcb.retransmit_num > 0) {
+        xtimer_usleep(US_PER_MS);
+    }
+    usec = xtimer_now_usec() - start;
+    gnrc_tcp_close(&tcb);
+
+    printf("%u bytes in %" PRIu32 " ms: %" PRIu32 " bytes/s, srtt %" PRIi32
+           " ms, cwnd %" PRIu32 " bytes\n", (unsigned)sent, usec / US_PER_MS,
+           (uint32_t)(((uint64_t)sent * US_PER_SEC) / usec),
+           tcb.srtt / (int32_t)US_PER_MS, tcb.cwnd);
+    return 0;
+}
+
+int main(void)
+{
+    ipv6_addr_t addr;
+
+    if (ipv6_addr_from_str(&addr, TARGET_ADDR) == NULL) {
+        puts("error: invalid target address");
+        return 1;
+    }
+    memset(_buf, 0xa5, sizeof(_buf));
+    printf("gnrc_tcp benchmark: [%s]:%u, %u segments in flight\n", TARGET_ADDR,
+           TARGET_PORT, GNRC_TCP_RETRANSMIT_QUEUE_SIZE);
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        if (_run(&addr) < 0) {
+            puts("FAILURE");
+            return 1;
+        }
+    }
+    puts("SUCCESS");
+    return 0;
+}
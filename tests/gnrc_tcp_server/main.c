@@ -22,6 +22,11 @@
 #define CONNS (1)
 #endif
 
+/* Number of connections that can be established before they are accepted */
+#ifndef BACKLOG
+#define BACKLOG (CONNS)
+#endif
+
 /* Amount of data to transmit */
 #ifndef NBYTE
 #define NBYTE (2048)
@@ -40,6 +45,10 @@
 uint8_t bufs[CONNS][NBYTE];
 uint8_t stacks[CONNS][THREAD_STACKSIZE_DEFAULT + THREAD_EXTRA_STACKSIZE_PRINTF];
 
+/* Listen queue, shared by all server threads */
+gnrc_tcp_tcb_queue_t queue;
+gnrc_tcp_tcb_t tcbs[BACKLOG];
+
 /* "ifconfig" shell command */
 extern int _gnrc_netif_config(int argc, char **argv);
 
@@ -62,7 +71,17 @@ int main(void)
 
     /* Test configuration */
     printf("\nStarting server: LOCAL_ADDR=%s, LOCAL_PORT=%d, ", LOCAL_ADDR, LOCAL_PORT);
-    printf("CONNS=%d, NBYTE=%d, CYCLES=%d\n\n",  CONNS, NBYTE, CYCLES);
+    printf("CONNS=%d, BACKLOG=%d, NBYTE=%d, CYCLES=%d\n\n",  CONNS, BACKLOG, NBYTE, CYCLES);
+
+    /* Listen for connections */
+    for (int i = 0; i < BACKLOG; i += 1) {
+        gnrc_tcp_tcb_init(&tcbs[i]);
+    }
+    int ret = gnrc_tcp_listen(&queue, tcbs, BACKLOG, AF_INET6, NULL, LOCAL_PORT);
+    if (ret < 0) {
+        printf("gnrc_tcp_listen() : %d\n", ret);
+        return -1;
+    }
 
     /* Start Threads to handle connections */
     for (int i = 0; i < CONNS; i += 1) {
@@ -79,46 +98,35 @@ void *srv_thread(void *arg)
     uint32_t cycles_ok = 0;
     uint32_t failed_payload_verifications = 0;
 
-    /* Transmission control block */
-    gnrc_tcp_tcb_t tcb;
+    /* Transmission control block of the accepted connection */
+    gnrc_tcp_tcb_t *tcb;
 
     /* Connection handling code */
     printf("Server running: TID=%d\n", tid);
     while (cycles < CYCLES) {
-        /* Initialize TCB struct */
-        gnrc_tcp_tcb_init(&tcb);
-
-        /* Connect to peer */
-        int ret = gnrc_tcp_open_passive(&tcb, AF_INET6, NULL, LOCAL_PORT);
+        /* Accept connection from peer */
+        int ret = gnrc_tcp_accept(&queue, &tcb, GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
         switch (ret) {
             case 0:
-                DEBUG("TID=%d : gnrc_tcp_open_passive() : 0 : ok\n", tid);
+                DEBUG("TID=%d : gnrc_tcp_accept() : 0 : ok\n", tid);
                 break;
 
-            case -EISCONN:
-                printf("TID=%d : gnrc_tcp_open_passive() : -EISCONN\n", tid);
-                return 0;
+            case -ETIMEDOUT:
+                DEBUG("TID=%d : gnrc_tcp_accept() : -ETIMEDOUT : retry\n", tid);
+                continue;
 
             case -EINVAL:
-                printf("TID=%d : gnrc_tcp_open_passive() : -EINVAL\n", tid);
-                return 0;
-
-            case -EAFNOSUPPORT:
-                printf("TID=%d : gnrc_tcp_open_passive() : -EAFNOSUPPORT\n", tid);
-                return 0;
-
-            case -ENOMEM:
-                printf("TID=%d : gnrc_tcp_open_passive() : -ENOMEM\n", tid);
+                printf("TID=%d : gnrc_tcp_accept() : -EINVAL\n", tid);
                 return 0;
 
             default:
-                printf("TID=%d : gnrc_tcp_open_passive() : %d\n", tid, ret);
+                printf("TID=%d : gnrc_tcp_accept() : %d\n", tid, ret);
                 return 0;
         }
 
         /* Receive data, stop if errors were found */
         for (size_t rcvd = 0; rcvd < sizeof(bufs[tid]) && ret >= 0; rcvd += ret) {
-            ret = gnrc_tcp_recv(&tcb, (void *) (bufs[tid] + rcvd), sizeof(bufs[tid]) - rcvd,
+            ret = gnrc_tcp_recv(tcb, (void *) (bufs[tid] + rcvd), sizeof(bufs[tid]) - rcvd,
                                 GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
             switch (ret) {
                 case -ENOTCONN:
@@ -170,7 +178,7 @@ void *srv_thread(void *arg)
 
         /* Send data, stop if errors were found */
         for (size_t sent = 0; sent < sizeof(bufs[tid]) && ret >= 0; sent += ret) {
-            ret = gnrc_tcp_send(&tcb, bufs[tid] + sent, sizeof(bufs[tid]) - sent, 0);
+            ret = gnrc_tcp_send(tcb, bufs[tid] + sent, sizeof(bufs[tid]) - sent, 0);
             switch (ret) {
                 case -ENOTCONN:
                     printf("TID=%d : gnrc_tcp_send() : -ENOTCONN\n", tid);
@@ -200,7 +208,7 @@ void *srv_thread(void *arg)
         }
 
         /* Close connection */
-        gnrc_tcp_close(&tcb);
+        gnrc_tcp_close(tcb);
 
         /* Gather data */
         cycles += 1;
@@ -351,6 +351,31 @@ static void test_sock_udp_recv4__non_blocking(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_buf4__success(void)
+{
+    static const sock_udp_ep_t local = { .family = AF_INET,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_4packet(_TEST_ADDR4_REMOTE, _TEST_ADDR4_LOCAL, _TEST_PORT_REMOTE,
+                           _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                           _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, &result));
+    assert((data != NULL) && (ctx != NULL));
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(AF_INET == result.family);
+    assert(htonl(_TEST_ADDR4_REMOTE) == result.addr.ipv4_u32);
+    assert(_TEST_PORT_REMOTE == result.port);
+#if LWIP_NETBUF_RECVINFO
+    assert(_TEST_NETIF == result.netif);
+#endif
+    sock_udp_recv_buf_free(ctx);
+    assert(_check_net());
+}
+
 static void test_sock_udp_send4__EAFNOSUPPORT(void)
 {
     const sock_udp_ep_t remote = { .addr = { .ipv4_u32 = htonl(_TEST_ADDR4_REMOTE) },
@@ -615,6 +640,37 @@ static void test_sock_udp_send4__no_sock(void)
     xtimer_usleep(1000);    /* let lwIP stack finish */
     assert(_check_net());
 }
+
+static void test_sock_udp_send4__zero_len(void)
+{
+    const sock_udp_ep_t local = { .addr = { .ipv4_u32 = htonl(_TEST_ADDR4_LOCAL) },
+                                  .family = AF_INET,
+                                  .netif = _TEST_NETIF,
+                                  .port = _TEST_PORT_LOCAL };
+    const sock_udp_ep_t remote = { .addr = { .ipv4_u32 = htonl(_TEST_ADDR4_REMOTE) },
+                                   .family = AF_INET,
+                                   .port = _TEST_PORT_REMOTE };
+    const struct iovec vector[] = {
+        { .iov_base = "AB", .iov_len = sizeof("AB") - 1 },
+        { .iov_base = NULL, .iov_len = 0 },
+        { .iov_base = "CD", .iov_len = sizeof("CD") },
+        { .iov_base = NULL, .iov_len = 0 },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(0 == sock_udp_send(&_sock, NULL, 0, &remote));
+    assert(_check_4packet(_TEST_ADDR4_LOCAL, _TEST_ADDR4_REMOTE, _TEST_PORT_LOCAL,
+                          _TEST_PORT_REMOTE, "", 0, _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let lwIP stack finish */
+    assert(sizeof("ABCD") == sock_udp_sendv(&_sock, vector,
+                                            sizeof(vector) / sizeof(vector[0]),
+                                            &remote));
+    assert(_check_4packet(_TEST_ADDR4_LOCAL, _TEST_ADDR4_REMOTE, _TEST_PORT_LOCAL,
+                          _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let lwIP stack finish */
+    assert(_check_net());
+}
 #endif /* MODULE_LWIP_IPV4 */
 
 #ifdef MODULE_LWIP_IPV6
@@ -947,6 +1003,33 @@ static void test_sock_udp_recv6__non_blocking(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_buf6__success(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR6_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR6_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_6packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                           _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                           _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, &result));
+    assert((data != NULL) && (ctx != NULL));
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(AF_INET6 == result.family);
+    assert(memcmp(&result.addr, &src_addr, sizeof(result.addr)) == 0);
+    assert(_TEST_PORT_REMOTE == result.port);
+#if LWIP_NETBUF_RECVINFO
+    assert(_TEST_NETIF == result.netif);
+#endif
+    sock_udp_recv_buf_free(ctx);
+    assert(_check_net());
+}
+
 static void test_sock_udp_send6__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR6_REMOTE },
@@ -1228,6 +1311,39 @@ static void test_sock_udp_send6__no_sock(void)
     xtimer_usleep(1000);    /* let lwIP stack finish */
     assert(_check_net());
 }
+
+static void test_sock_udp_send6__zero_len(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR6_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR6_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR6_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR6_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    const struct iovec vector[] = {
+        { .iov_base = "AB", .iov_len = sizeof("AB") - 1 },
+        { .iov_base = NULL, .iov_len = 0 },
+        { .iov_base = "CD", .iov_len = sizeof("CD") },
+        { .iov_base = NULL, .iov_len = 0 },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(0 == sock_udp_send(&_sock, NULL, 0, &remote));
+    assert(_check_6packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                          _TEST_PORT_REMOTE, "", 0, _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let lwIP stack finish */
+    assert(sizeof("ABCD") == sock_udp_sendv(&_sock, vector,
+                                            sizeof(vector) / sizeof(vector[0]),
+                                            &remote));
+    assert(_check_6packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                          _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let lwIP stack finish */
+    assert(_check_net());
+}
 #endif /* MODULE_LWIP_IPV6 */
 
 int main(void)
@@ -1273,6 +1389,7 @@ int main(void)
     CALL(test_sock_udp_recv4__unsocketed_with_remote());
     CALL(test_sock_udp_recv4__with_timeout());
     CALL(test_sock_udp_recv4__non_blocking());
+    CALL(test_sock_udp_recv_buf4__success());
     _prepare_send_checks();
     CALL(test_sock_udp_send4__EAFNOSUPPORT());
     CALL(test_sock_udp_send4__EINVAL_addr());
@@ -1291,6 +1408,7 @@ int main(void)
     CALL(test_sock_udp_send4__unsocketed());
     CALL(test_sock_udp_send4__no_sock_no_netif());
     CALL(test_sock_udp_send4__no_sock());
+    CALL(test_sock_udp_send4__zero_len());
 #endif /* MODULE_LWIP_IPV4 */
 #ifdef MODULE_LWIP_IPV6
 #ifdef SO_REUSE
@@ -1318,6 +1436,7 @@ int main(void)
     CALL(test_sock_udp_recv6__unsocketed_with_remote());
     CALL(test_sock_udp_recv6__with_timeout());
     CALL(test_sock_udp_recv6__non_blocking());
+    CALL(test_sock_udp_recv_buf6__success());
     _prepare_send_checks();
     CALL(test_sock_udp_send6__EAFNOSUPPORT());
     CALL(test_sock_udp_send6__EINVAL_addr());
@@ -1336,6 +1455,7 @@ int main(void)
     CALL(test_sock_udp_send6__unsocketed());
     CALL(test_sock_udp_send6__no_sock_no_netif());
     CALL(test_sock_udp_send6__no_sock());
+    CALL(test_sock_udp_send6__zero_len());
 #endif /* MODULE_LWIP_IPV6 */
 
     puts("ALL TESTS SUCCESSFUL");
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput of msg_send_bulk()/msg_receive_bulk() compared to
+ *              msg_send()/msg_receive()
+ *
+ * The main thread produces messages for a consumer of higher priority, which
+ * is the worst case for single messages as every msg_send() switches to the
+ * consumer. The consumer checks that all messages arrive in order.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_BULK
+#define TEST_BULK           (8U)
+#endif
+
+#ifndef TEST_MSG_NUMOF
+#define TEST_MSG_NUMOF      (8192U)
+#endif
+
+#define QUEUE_SIZE          (16U)
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static unsigned _bulk;
+static unsigned _errors;
+
+static void *_consumer(void *arg)
+{
+    msg_t queue[QUEUE_SIZE];
+    msg_t msgs[TEST_BULK];
+    uint32_t expected = 0;
+
+    (void)arg;
+    msg_init_queue(queue, QUEUE_SIZE);
+    while (1) {
+        unsigned num;
+
+        if (_bulk > 1) {
+            num = msg_receive_bulk(msgs, _bulk);
+        }
+        else {
+            num = msg_receive(msgs);
+        }
+        for (unsigned i = 0; i < num; i++) {
+            if (msgs[i].content.value != expected) {
+                _errors++;
+            }
+            expected = msgs[i].content.value + 1;
+            if (expected == TEST_MSG_NUMOF) {
+                expected = 0;
+                mutex_unlock(&_done);
+            }
+        }
+    }
+    return NULL;
+}
+
+static uint32_t _run(kernel_pid_t consumer, unsigned bulk)
+{
+    msg_t msgs[TEST_BULK];
+    uint32_t start;
+
+    _bulk = bulk;
+    start = xtimer_now_usec();
+    for (uint32_t value = 0; value < TEST_MSG_NUMOF; value += bulk) {
+        unsigned num = (TEST_MSG_NUMOF - value < bulk) ? TEST_MSG_NUMOF - value
+                                                       : bulk;
+
+        for (unsigned i = 0; i < num; i++) {
+            msgs[i].content.value = value + i;
+        }
+        if (bulk > 1) {
+            msg_send_bulk(msgs, num, consumer);
+        }
+        else {
+            msg_send(msgs, consumer);
+        }
+    }
+    mutex_lock(&_done);
+    return xtimer_now_usec() - start;
+}
+
+static void _print(const char *name, uint32_t usec)
+{
+    printf("%s: %" PRIu32 " msgs/s (%" PRIu32 " us for %u messages)\n", name,
+           (uint32_t)(((uint64_t)TEST_MSG_NUMOF * US_PER_SEC) / usec), usec,
+           TEST_MSG_NUMOF);
+}
+
+int main(void)
+{
+    kernel_pid_t consumer;
+
+    consumer = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                             THREAD_CREATE_STACKTEST, _consumer, NULL,
+                             "consumer");
+    _print("single", _run(consumer, 1));
+    _print("bulk", _run(consumer, TEST_BULK));
+    if (_errors) {
+        printf("%u messages out of order\n", _errors);
+        puts("FAILURE");
+        return 1;
+    }
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for the flash semantics of mtd_native and benchmark
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mtd_native.h"
+#include "xtimer.h"
+
+#ifndef TEST_SECTORS
+#define TEST_SECTORS        (64U)
+#endif
+
+#define TEST_PAGE_SIZE      (256U)
+#define TEST_SECTOR_SIZE    (4096U)
+
+static mtd_native_dev_t _dev = {
+    .dev = {
+        .driver = &native_flash_driver,
+        .sector_count = TEST_SECTORS,
+        .pages_per_sector = TEST_SECTOR_SIZE / TEST_PAGE_SIZE,
+        .page_size = TEST_PAGE_SIZE,
+    },
+    .fname = "./bin/mtd_native_test.bin",
+};
+static mtd_dev_t *_mtd = (mtd_dev_t *)&_dev;
+static uint8_t _buf[TEST_SECTOR_SIZE];
+
+#define CHECK(cond) \
+    if (!(cond)) { \
+        printf("error: %s failed in line %d\n", #cond, __LINE__); \
+        puts("FAILURE"); \
+        return 1; \
+    }
+
+static bool _all(const uint8_t *buf, uint8_t val, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != val) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t _kib_per_sec(uint32_t bytes, uint32_t usec)
+{
+    return (uint32_t)(((uint64_t)bytes * US_PER_SEC) / 1024 / (usec ? usec : 1));
+}
+
+static int _test_semantics(void)
+{
+    uint8_t val;
+
+    CHECK(mtd_erase(_mtd, 0, TEST_SECTOR_SIZE) == 0);
+    CHECK(mtd_read(_mtd, _buf, 0, TEST_SECTOR_SIZE) == TEST_SECTOR_SIZE);
+    CHECK(_all(_buf, 0xff, TEST_SECTOR_SIZE));
+
+    /* programming only clears bits */
+    val = 0x0f;
+    CHECK(mtd_write(_mtd, &val, 0, 1) == 1);
+    val = 0xf0;
+    CHECK(mtd_write(_mtd, &val, 0, 1) == 1);
+    CHECK(mtd_read(_mtd, &val, 0, 1) == 1);
+    CHECK(val == 0x00);
+
+    /* unless strict, when setting bits is an error */
+    _dev.flags = MTD_NATIVE_FLAG_STRICT;
+    val = 0x01;
+    CHECK(mtd_write(_mtd, &val, 0, 1) == -EIO);
+    CHECK(mtd_write(_mtd, &val, 1, 1) == 1);
+    _dev.flags = 0;
+
+    /* writes must not cross sectors */
+    CHECK(mtd_write(_mtd, _buf, TEST_SECTOR_SIZE - 1, 2) == -EOVERFLOW);
+
+    /* an interrupted write only programs part of the data */
+    memset(_buf, 0, 16);
+    mtd_native_inject_fault(&_dev, 2);
+    CHECK(mtd_write(_mtd, _buf, 16, 1) == 1);
+    CHECK(mtd_write(_mtd, _buf, 32, 16) == -EIO);
+    CHECK(mtd_read(_mtd, _buf, 32, 16) == 16);
+    CHECK(_all(_buf, 0x00, 8) && _all(_buf + 8, 0xff, 8));
+
+    /* an interrupted erase only erases part of the sector */
+    mtd_native_inject_fault(&_dev, 1);
+    CHECK(mtd_erase(_mtd, 0, TEST_SECTOR_SIZE) == -EIO);
+    CHECK(mtd_read(_mtd, _buf, 0, TEST_SECTOR_SIZE) == TEST_SECTOR_SIZE);
+    CHECK(_all(_buf, 0xff, TEST_SECTOR_SIZE));
+    memset(_buf, 0, TEST_SECTOR_SIZE);
+    CHECK(mtd_write(_mtd, _buf, 0, TEST_SECTOR_SIZE) == TEST_SECTOR_SIZE);
+    mtd_native_inject_fault(&_dev, 1);
+    CHECK(mtd_erase(_mtd, 0, TEST_SECTOR_SIZE) == -EIO);
+    CHECK(mtd_read(_mtd, _buf, 0, TEST_SECTOR_SIZE) == TEST_SECTOR_SIZE);
+    CHECK(_all(_buf, 0xff, TEST_SECTOR_SIZE / 2));
+    CHECK(_all(_buf + TEST_SECTOR_SIZE / 2, 0x00, TEST_SECTOR_SIZE / 2));
+
+    /* sectors wear out */
+    CHECK(mtd_native_wear(&_dev, 1) == 0);
+    CHECK(mtd_erase(_mtd, TEST_SECTOR_SIZE, TEST_SECTOR_SIZE) == 0);
+    CHECK(mtd_native_wear(&_dev, 1) == 1);
+    _dev.endurance = 2;
+    CHECK(mtd_erase(_mtd, TEST_SECTOR_SIZE, TEST_SECTOR_SIZE) == 0);
+    CHECK(mtd_erase(_mtd, TEST_SECTOR_SIZE, TEST_SECTOR_SIZE) == -EIO);
+    CHECK(mtd_native_wear(&_dev, 1) == 2);
+    _dev.endurance = 0;
+
+    CHECK(mtd_power(_mtd, MTD_POWER_DOWN) == 0);
+    return 0;
+}
+
+static int _benchmark(void)
+{
+    uint32_t start, usec;
+
+    memset(_buf, 0xa5, sizeof(_buf));
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_SECTORS; i++) {
+        for (unsigned page = 0; page < TEST_SECTOR_SIZE; page += TEST_PAGE_SIZE) {
+            CHECK(mtd_write(_mtd, _buf, (i * TEST_SECTOR_SIZE) + page,
+                            TEST_PAGE_SIZE) == TEST_PAGE_SIZE);
+        }
+    }
+    usec = xtimer_now_usec() - start;
+    printf("write: %" PRIu32 " KiB/s\n",
+           _kib_per_sec(TEST_SECTORS * TEST_SECTOR_SIZE, usec));
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_SECTORS; i++) {
+        CHECK(mtd_read(_mtd, _buf, i * TEST_SECTOR_SIZE,
+                       TEST_SECTOR_SIZE) == TEST_SECTOR_SIZE);
+    }
+    usec = xtimer_now_usec() - start;
+    printf("read: %" PRIu32 " KiB/s\n",
+           _kib_per_sec(TEST_SECTORS * TEST_SECTOR_SIZE, usec));
+
+    start = xtimer_now_usec();
+    CHECK(mtd_erase(_mtd, 0, TEST_SECTORS * TEST_SECTOR_SIZE) == 0);
+    usec = xtimer_now_usec() - start;
+    printf("erase: %" PRIu32 " sectors/s\n",
+           (uint32_t)(((uint64_t)TEST_SECTORS * US_PER_SEC) / (usec ? usec : 1)));
+
+    CHECK(mtd_native_flush(&_dev) == 0);
+    return 0;
+}
+
+int main(void)
+{
+    puts("mtd_native test");
+    if (mtd_init(_mtd) != 0) {
+        puts("error: unable to initialize device");
+        puts("FAILURE");
+        return 1;
+    }
+    if ((_test_semantics() != 0) || (_benchmark() != 0)) {
+        return 1;
+    }
+    puts("SUCCESS");
+    return 0;
+}
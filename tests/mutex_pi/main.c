@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the priority inheritance of mutexes
+ *
+ * The owner of a mutex has to keep an inherited priority while it locks and
+ * unlocks other mutexes, and has to lose it once the waiter times out or the
+ * mutex is passed on.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "thread.h"
+#include "mutex.h"
+#include "xtimer.h"
+
+#define PRIO_LOW        (THREAD_PRIORITY_MAIN - 1)
+#define PRIO_HIGH       (THREAD_PRIORITY_MAIN - 2)
+
+#define LOCK_TIMEOUT    (100U * US_PER_MS)
+#define SETTLE_TIME     (10U * US_PER_MS)
+
+static char stack_low[THREAD_STACKSIZE_DEFAULT];
+static char stack_high[THREAD_STACKSIZE_DEFAULT];
+
+static mutex_t res_a = MUTEX_INIT;
+static mutex_t res_b = MUTEX_INIT;
+
+static kernel_pid_t pid_low;
+static kernel_pid_t pid_high;
+static volatile int timeout_res;
+static unsigned failed;
+
+static void *t_low_handler(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&res_a);
+    thread_sleep();
+
+    /* use other mutexes while holding res_a */
+    mutex_lock(&res_b);
+    mutex_unlock(&res_b);
+    xtimer_usleep(US_PER_MS);
+    thread_sleep();
+
+    mutex_unlock(&res_a);
+    while (1) {
+        thread_sleep();
+    }
+    return NULL;
+}
+
+static void *t_high_handler(void *arg)
+{
+    (void)arg;
+
+    timeout_res = xtimer_mutex_lock_timeout(&res_a, LOCK_TIMEOUT);
+    thread_sleep();
+
+    mutex_lock(&res_a);
+    mutex_unlock(&res_a);
+    while (1) {
+        thread_sleep();
+    }
+    return NULL;
+}
+
+static void _check(const char *step, unsigned prio)
+{
+    unsigned is = thread_get(pid_low)->priority;
+
+    if (is == prio) {
+        printf("%s: OK\n", step);
+    }
+    else {
+        printf("%s: FAILED (prio %u, expected %u)\n", step, is, prio);
+        failed++;
+    }
+}
+
+int main(void)
+{
+    puts("Mutex priority inheritance test");
+
+    pid_low = thread_create(stack_low, sizeof(stack_low), PRIO_LOW,
+                            THREAD_CREATE_STACKTEST, t_low_handler, NULL,
+                            "t_low");
+    pid_high = thread_create(stack_high, sizeof(stack_high), PRIO_HIGH,
+                             THREAD_CREATE_STACKTEST, t_high_handler, NULL,
+                             "t_high");
+    _check("boost on timed lock", PRIO_HIGH);
+
+    thread_wakeup(pid_low);
+    xtimer_usleep(SETTLE_TIME);
+    _check("boost kept while owner sleeps", PRIO_HIGH);
+
+    xtimer_usleep(LOCK_TIMEOUT);
+    if (timeout_res != -1) {
+        puts("lock did not time out: FAILED");
+        failed++;
+    }
+    _check("boost dropped on timeout", PRIO_LOW);
+
+    thread_wakeup(pid_high);
+    _check("boost on lock", PRIO_HIGH);
+
+    thread_wakeup(pid_low);
+    _check("boost dropped on unlock", PRIO_LOW);
+
+    puts(failed ? "[FAILED]" : "[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput benchmark for netdev_tap
+ *
+ * Sends frames on the first tap interface and receives them on the second
+ * one, which needs to be bridged with the first on the host. Reports the
+ * frame rates, lost frames and how many frames were received per interrupt.
+ * Build with e.g. `CFLAGS=-DNETDEV_TAP_RX_BATCH=1` to compare against
+ * receiving one frame per interrupt.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "net/ethernet.h"
+#include "net/ethernet/hdr.h"
+#include "netdev_tap.h"
+#include "netdev_tap_params.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_FRAMES
+#define TEST_FRAMES         (10000U)
+#endif
+
+#ifndef TEST_PAYLOAD_SIZE
+#define TEST_PAYLOAD_SIZE   (64U)
+#endif
+
+/* IEEE 802 local experimental ethertype */
+#define TEST_ETHERTYPE      (0x88b5)
+#define TEST_TIMEOUT        (1U * US_PER_SEC)
+#define RCV_MSG_QUEUE_SIZE  (8U)
+#define MSG_TYPE_ISR        (0x3456)
+
+static netdev_tap_t _devs[2];
+static char _rcv_stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _rcv_pid;
+static uint8_t _frame[sizeof(ethernet_hdr_t) + TEST_PAYLOAD_SIZE];
+
+static volatile unsigned _rx_frames;
+static volatile unsigned _rx_isrs;
+static volatile uint32_t _rx_last;
+
+static void _event_cb(netdev_t *dev, netdev_event_t event)
+{
+    if (event == NETDEV_EVENT_ISR) {
+        msg_t msg = { .type = MSG_TYPE_ISR, .content = { .ptr = dev } };
+
+        msg_send(&msg, _rcv_pid);
+    }
+    else if (event == NETDEV_EVENT_RX_COMPLETE) {
+        static uint8_t buf[ETHERNET_FRAME_LEN];
+        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
+        int len = dev->driver->recv(dev, buf, sizeof(buf), NULL);
+
+        if ((len >= (int)(sizeof(ethernet_hdr_t) + TEST_PAYLOAD_SIZE)) &&
+            (byteorder_ntohs(hdr->type) == TEST_ETHERTYPE)) {
+            _rx_frames++;
+            _rx_last = xtimer_now_usec();
+        }
+    }
+}
+
+static void *_rcv_thread(void *arg)
+{
+    msg_t msg, msg_queue[RCV_MSG_QUEUE_SIZE];
+
+    (void)arg;
+    msg_init_queue(msg_queue, RCV_MSG_QUEUE_SIZE);
+    while (1) {
+        msg_receive(&msg);
+        if (msg.type == MSG_TYPE_ISR) {
+            netdev_t *dev = msg.content.ptr;
+
+            _rx_isrs++;
+            dev->driver->isr(dev);
+        }
+    }
+    return NULL;
+}
+
+static int _init(netdev_tap_t *dev, const netdev_tap_params_t *params)
+{
+    netdev_tap_setup(dev, params);
+    dev->netdev.event_callback = _event_cb;
+    return dev->netdev.driver->init(&dev->netdev);
+}
+
+int main(void)
+{
+    netdev_t *tx = &_devs[0].netdev;
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)_frame;
+    struct iovec vector = {
+        .iov_base = _frame,
+        .iov_len = sizeof(_frame),
+    };
+    uint32_t start, tx_usec, rx_usec;
+
+    puts("netdev_tap benchmark");
+    _rcv_pid = thread_create(_rcv_stack, sizeof(_rcv_stack),
+                             THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                             _rcv_thread, NULL, "rcv");
+    if ((_init(&_devs[0], &netdev_tap_params[0]) < 0) ||
+        (_init(&_devs[1], &netdev_tap_params[1]) < 0)) {
+        puts("error: unable to initialize tap interfaces");
+        return 1;
+    }
+    memcpy(hdr->dst, _devs[1].addr, ETHERNET_ADDR_LEN);
+    memcpy(hdr->src, _devs[0].addr, ETHERNET_ADDR_LEN);
+    hdr->type = byteorder_htons(TEST_ETHERTYPE);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_FRAMES; i++) {
+        if (tx->driver->send(tx, &vector, 1) < 0) {
+            puts("error: unable to send frame");
+            return 1;
+        }
+    }
+    tx_usec = xtimer_now_usec() - start;
+    /* wait for frames still in flight */
+    while ((_rx_frames < TEST_FRAMES) &&
+           ((xtimer_now_usec() - start) < (tx_usec + TEST_TIMEOUT))) {
+        xtimer_usleep(10U * US_PER_MS);
+    }
+    rx_usec = _rx_last - start;
+
+    printf("tx: %" PRIu32 " frames/s\n",
+           (uint32_t)(((uint64_t)TEST_FRAMES * US_PER_SEC) /
+                      (tx_usec ? tx_usec : 1)));
+    printf("rx: %u of %u frames, %" PRIu32 " frames/s, %u frames per "
+           "interrupt\n", _rx_frames, TEST_FRAMES,
+           (uint32_t)(((uint64_t)_rx_frames * US_PER_SEC) /
+                      (rx_usec ? rx_usec : 1)),
+           _rx_isrs ? (_rx_frames / _rx_isrs) : 0);
+    puts((_rx_frames > 0) ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for scheduler profiling
+ *
+ * A worker thread blocks on messages, a mutex and sleeps in turns. The
+ * profile and the context switch trace are printed afterwards.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "sched_profile.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS     (8U)
+#endif
+
+#define TEST_SLEEP      (2U * US_PER_MS)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _lock = MUTEX_INIT;
+
+static void *_worker(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        msg_receive(&msg);
+        /* blocks until main releases the lock */
+        mutex_lock(&_lock);
+        mutex_unlock(&_lock);
+        xtimer_usleep(TEST_SLEEP);
+        msg_send(&msg, msg.sender_pid);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    kernel_pid_t pid;
+
+    sched_profile_reset();
+    pid = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                        THREAD_CREATE_STACKTEST, _worker, NULL, "worker");
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        msg_t msg;
+
+        mutex_lock(&_lock);
+        msg_send(&msg, pid);
+        xtimer_usleep(TEST_SLEEP);
+        mutex_unlock(&_lock);
+        msg_receive(&msg);
+    }
+    sched_profile_print();
+    sched_profile_print_trace();
+    puts("SUCCESS");
+    return 0;
+}
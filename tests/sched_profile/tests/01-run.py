@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import json
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect(r"isr: \d+ times, \d+ us total, \d+ us max")
+    child.expect_exact('{"traceEvents":[')
+    child.expect_exact("]}")
+    trace = json.loads('{"traceEvents":[' + child.before + ']}')
+    assert any(e["ph"] == "B" and e["tid"] > 0 for e in trace["traceEvents"])
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
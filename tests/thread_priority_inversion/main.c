@@ -27,7 +27,11 @@
 #include "mutex.h"
 #include "xtimer.h"
 
+/* number of times t_high has to get the resource while t_mid is running */
+#define TEST_ROUNDS     (3U)
+
 mutex_t res_mtx;
+volatile int mid_running;
 
 char stack_high[THREAD_STACKSIZE_DEFAULT];
 char stack_mid[THREAD_STACKSIZE_DEFAULT];
@@ -60,6 +64,7 @@ void *t_mid_handler(void *arg)
     xtimer_sleep(3);
 
     puts("t_mid: doing some stupid stuff...");
+    mid_running = 1;
     while (1) {
         thread_yield_higher();
     }
@@ -67,6 +72,8 @@ void *t_mid_handler(void *arg)
 
 void *t_high_handler(void *arg)
 {
+    unsigned rounds = 0;
+
     (void) arg;
 
     /* starting working loop after 500 ms */
@@ -75,6 +82,9 @@ void *t_high_handler(void *arg)
         puts("t_high: allocating resource...");
         mutex_lock(&res_mtx);
         puts("t_high: got resource.");
+        if (mid_running && (++rounds == TEST_ROUNDS)) {
+            puts("[SUCCESS]");
+        }
         xtimer_sleep(1);
 
         puts("t_high: freeing resource...");
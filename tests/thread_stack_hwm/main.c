@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for the stack high-water marks tracked at context switch
+ *
+ * A thread fills a buffer on its stack, returns from doing so and blocks.
+ * Its high-water mark must then account for the buffer without exceeding
+ * what scanning the whole stack finds.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "ps.h"
+#include "thread.h"
+
+#define BUF_SIZE    (512U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT + BUF_SIZE];
+
+static char __attribute__((noinline)) _use_stack(void)
+{
+    volatile char buf[BUF_SIZE];
+
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        buf[i] = (char)i;
+    }
+    return buf[BUF_SIZE - 1];
+}
+
+static void *_thread(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    (void)_use_stack();
+    msg_receive(&msg);
+    return NULL;
+}
+
+int main(void)
+{
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1, 0, _thread,
+                                     NULL, "hwm");
+    int hwm_free = thread_stack_hwm_free(pid);
+    int used = (int)sizeof(_stack) - hwm_free;
+
+    printf("stack high-water mark: %d of %u bytes used\n", used,
+           (unsigned)sizeof(_stack));
+#ifdef DEVELHELP
+    /* tracking may miss usage beyond large untouched gaps, but never reports
+     * more than there is */
+    int scan_free = thread_measure_stack_free(thread_get(pid)->stack_start);
+    printf("scanned: %d bytes free, tracked: %d bytes free\n", scan_free,
+           hwm_free);
+    if (hwm_free < scan_free) {
+        puts("[FAILED]");
+        return 1;
+    }
+#endif
+    if ((used < (int)BUF_SIZE) ||
+        (thread_stack_hwm_free(KERNEL_PID_UNDEF) != -1)) {
+        puts("[FAILED]");
+        return 1;
+    }
+    ps();
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+
+#include "embUnit.h"
+
+#include "objpool.h"
+
+#include "tests-core.h"
+
+/* more than one bitmap word */
+#define TEST_OBJPOOL_NUMOF  (OBJPOOL_BITMAP_BITS + 3)
+
+typedef struct {
+    uint32_t a;
+    uint8_t b;
+} test_obj_t;
+
+static test_obj_t objs[TEST_OBJPOOL_NUMOF];
+static unsigned used[OBJPOOL_BITMAP_NUMOF(TEST_OBJPOOL_NUMOF)];
+static objpool_t pool;
+
+static void set_up(void)
+{
+    objpool_init(&pool, objs, sizeof(test_obj_t), TEST_OBJPOOL_NUMOF, used);
+}
+
+static void test_objpool_static_init(void)
+{
+    static test_obj_t static_objs[3];
+    static unsigned static_used[OBJPOOL_BITMAP_NUMOF(3)];
+    static objpool_t static_pool = OBJPOOL_INIT(static_objs, static_used);
+
+    TEST_ASSERT_EQUAL_INT(3, static_pool.numof);
+    TEST_ASSERT_EQUAL_INT(sizeof(test_obj_t), static_pool.size);
+    TEST_ASSERT(&static_objs[0] == objpool_alloc(&static_pool));
+}
+
+static void test_objpool_alloc_all(void)
+{
+    for (unsigned i = 0; i < TEST_OBJPOOL_NUMOF; i++) {
+        TEST_ASSERT(&objs[i] == objpool_alloc(&pool));
+        TEST_ASSERT_EQUAL_INT(i, objpool_index(&pool, &objs[i]));
+    }
+    TEST_ASSERT_NULL(objpool_alloc(&pool));
+    TEST_ASSERT_NULL(objpool_alloc(&pool));
+    TEST_ASSERT_EQUAL_INT(TEST_OBJPOOL_NUMOF, pool.count);
+    TEST_ASSERT_EQUAL_INT(TEST_OBJPOOL_NUMOF, pool.count_max);
+    TEST_ASSERT_EQUAL_INT(2, pool.fails);
+}
+
+static void test_objpool_free_lowest_first(void)
+{
+    for (unsigned i = 0; i < TEST_OBJPOOL_NUMOF; i++) {
+        objpool_alloc(&pool);
+    }
+    objpool_free(&pool, &objs[TEST_OBJPOOL_NUMOF - 1]);
+    objpool_free(&pool, &objs[1]);
+    TEST_ASSERT(!objpool_is_used(&pool, &objs[1]));
+    TEST_ASSERT(objpool_is_used(&pool, &objs[2]));
+    TEST_ASSERT_EQUAL_INT(TEST_OBJPOOL_NUMOF - 2, pool.count);
+    TEST_ASSERT(&objs[1] == objpool_alloc(&pool));
+    TEST_ASSERT(&objs[TEST_OBJPOOL_NUMOF - 1] == objpool_alloc(&pool));
+    TEST_ASSERT_NULL(objpool_alloc(&pool));
+    TEST_ASSERT_EQUAL_INT(TEST_OBJPOOL_NUMOF, pool.count_max);
+}
+
+static void test_objpool_take(void)
+{
+    TEST_ASSERT(objpool_take(&pool, &objs[0]));
+    TEST_ASSERT(!objpool_take(&pool, &objs[0]));
+    TEST_ASSERT(objpool_take(&pool, &objs[OBJPOOL_BITMAP_BITS]));
+    TEST_ASSERT_EQUAL_INT(2, pool.count);
+    TEST_ASSERT(&objs[1] == objpool_alloc(&pool));
+    objpool_free(&pool, &objs[0]);
+    TEST_ASSERT(&objs[0] == objpool_alloc(&pool));
+}
+
+Test *tests_core_objpool_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_objpool_static_init),
+        new_TestFixture(test_objpool_alloc_all),
+        new_TestFixture(test_objpool_free_lowest_first),
+        new_TestFixture(test_objpool_take),
+    };
+
+    EMB_UNIT_TESTCALLER(core_objpool_tests, set_up, NULL, fixtures);
+
+    return (Test *)&core_objpool_tests;
+}
@@ -21,6 +21,7 @@
 
 #define TEST_FIB_TABLE_SIZE (20)
 static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
+static fib_trie_node_t _trie[2 * TEST_FIB_TABLE_SIZE];
 static fib_table_t test_fib_table = { .data.entries = _entries,
                                       .table_type = FIB_TABLE_TYPE_SH,
                                       .size = TEST_FIB_TABLE_SIZE,
@@ -976,38 +977,143 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
-Test *tests_fib_tests(void)
+/*
+* @brief testing that the longest of several nested prefixes matches
+*/
+static void test_fib_21_longest_prefix_match(void)
+{
+    size_t add_buf_size = 16;
+    uint8_t addr_dst[add_buf_size];
+    uint8_t addr_nxt[add_buf_size];
+    uint8_t addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    memset(addr_dst, 0, add_buf_size);
+    memset(addr_nxt, 0, add_buf_size);
+    memset(addr_lookup, 0, add_buf_size);
+
+    /* default route via next-hop 0x01.. */
+    addr_nxt[0] = 0x01;
+    fib_add_entry(&test_fib_table, 42, addr_dst, add_buf_size, 0x123,
+                  addr_nxt, add_buf_size, 0x23, 100000);
+
+    /* 0x20 0x01 0x0d 0xb8::/32 via next-hop 0x02.. */
+    addr_dst[0] = 0x20;
+    addr_dst[1] = 0x01;
+    addr_dst[2] = 0x0d;
+    addr_dst[3] = 0xb8;
+    addr_nxt[0] = 0x02;
+    fib_add_entry(&test_fib_table, 42, addr_dst, add_buf_size,
+                  ((32UL << FIB_FLAG_NET_PREFIX_SHIFT) | 0x123),
+                  addr_nxt, add_buf_size, 0x23, 100000);
+
+    /* 0x20 0x01 0x0d 0xb8 0x00 0x01::/48 via next-hop 0x03.. */
+    addr_dst[5] = 0x01;
+    addr_nxt[0] = 0x03;
+    fib_add_entry(&test_fib_table, 42, addr_dst, add_buf_size,
+                  ((48UL << FIB_FLAG_NET_PREFIX_SHIFT) | 0x123),
+                  addr_nxt, add_buf_size, 0x23, 100000);
+
+    /* lookup within the /48 */
+    memcpy(addr_lookup, addr_dst, add_buf_size);
+    addr_lookup[15] = 0x42;
+    int ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                               addr_nxt, &add_buf_size, &next_hop_flags,
+                               addr_lookup, add_buf_size, 0x123);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(0x03, addr_nxt[0]);
+
+    /* lookup within the /32 only */
+    addr_lookup[5] = 0x02;
+    ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                           addr_nxt, &add_buf_size, &next_hop_flags,
+                           addr_lookup, add_buf_size, 0x123);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(0x02, addr_nxt[0]);
+
+    /* lookup outside of both prefixes */
+    addr_lookup[0] = 0x30;
+    ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                           addr_nxt, &add_buf_size, &next_hop_flags,
+                           addr_lookup, add_buf_size, 0x123);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(0x01, addr_nxt[0]);
+
+    /* removing the /48 makes the /32 match again */
+    fib_remove_entry(&test_fib_table, addr_dst, add_buf_size);
+    memcpy(addr_lookup, addr_dst, add_buf_size);
+    ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                           addr_nxt, &add_buf_size, &next_hop_flags,
+                           addr_lookup, add_buf_size, 0x123);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(0x02, addr_nxt[0]);
+
+#if (TEST_FIB_SHOW_OUTPUT == 1)
+    fib_print_fib_table(&test_fib_table);
+    puts("");
+    universal_address_print_table();
+    puts("");
+#endif
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief runs the tests on a table that indexes its entries with a prefix trie
+*/
+static void set_up_trie(void)
+{
+    test_fib_table.trie = _trie;
+    fib_init(&test_fib_table);
+}
+
+static void tear_down_trie(void)
 {
+    test_fib_table.trie = NULL;
     fib_init(&test_fib_table);
-    EMB_UNIT_TESTFIXTURES(fixtures) {
-        new_TestFixture(test_fib_01_fill_unique_entries),
-                        new_TestFixture(test_fib_02_fill_multiple_entries),
-                        new_TestFixture(test_fib_03_removing_all_entries),
-                        new_TestFixture(test_fib_04_remove_lower_half),
-                        new_TestFixture(test_fib_05_remove_upper_half),
-                        new_TestFixture(test_fib_06_remove_one_entry),
-                        new_TestFixture(test_fib_07_remove_one_entry_multiple_times),
-                        new_TestFixture(test_fib_08_remove_unknown),
-                        new_TestFixture(test_fib_09_update_entry),
-                        new_TestFixture(test_fib_10_add_exceed),
-                        new_TestFixture(test_fib_11_get_next_hop_success),
-                        new_TestFixture(test_fib_12_get_next_hop_fail),
-                        new_TestFixture(test_fib_13_get_next_hop_fail_on_buffer_size),
-                        new_TestFixture(test_fib_14_exact_and_prefix_match),
-                        new_TestFixture(test_fib_15_get_lifetime),
-                        new_TestFixture(test_fib_16_prefix_match),
-                        new_TestFixture(test_fib_17_get_entry_set),
-                        new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
-                        new_TestFixture(test_fib_19_default_gateway),
-                        new_TestFixture(test_fib_20_replace_prefix),
-    };
+}
+
+EMB_UNIT_TESTFIXTURES(fixtures) {
+    new_TestFixture(test_fib_01_fill_unique_entries),
+    new_TestFixture(test_fib_02_fill_multiple_entries),
+    new_TestFixture(test_fib_03_removing_all_entries),
+    new_TestFixture(test_fib_04_remove_lower_half),
+    new_TestFixture(test_fib_05_remove_upper_half),
+    new_TestFixture(test_fib_06_remove_one_entry),
+    new_TestFixture(test_fib_07_remove_one_entry_multiple_times),
+    new_TestFixture(test_fib_08_remove_unknown),
+    new_TestFixture(test_fib_09_update_entry),
+    new_TestFixture(test_fib_10_add_exceed),
+    new_TestFixture(test_fib_11_get_next_hop_success),
+    new_TestFixture(test_fib_12_get_next_hop_fail),
+    new_TestFixture(test_fib_13_get_next_hop_fail_on_buffer_size),
+    new_TestFixture(test_fib_14_exact_and_prefix_match),
+    new_TestFixture(test_fib_15_get_lifetime),
+    new_TestFixture(test_fib_16_prefix_match),
+    new_TestFixture(test_fib_17_get_entry_set),
+    new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
+    new_TestFixture(test_fib_19_default_gateway),
+    new_TestFixture(test_fib_20_replace_prefix),
+    new_TestFixture(test_fib_21_longest_prefix_match),
+};
 
+Test *tests_fib_tests(void)
+{
+    fib_init(&test_fib_table);
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
 
     return (Test *)&fib_tests;
 }
 
+Test *tests_fib_trie_tests(void)
+{
+    EMB_UNIT_TESTCALLER(fib_trie_tests, set_up_trie, tear_down_trie, fixtures);
+
+    return (Test *)&fib_trie_tests;
+}
+
 void tests_fib(void)
 {
     TESTS_RUN(tests_fib_tests());
+    TESTS_RUN(tests_fib_trie_tests());
 }
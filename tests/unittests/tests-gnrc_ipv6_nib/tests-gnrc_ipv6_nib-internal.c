@@ -343,6 +343,38 @@ static void test_nib_get__success(void)
     TEST_ASSERT(nib_alloced == nib_got);
 }
 
+/*
+ * Creates GNRC_IPV6_NIB_NUMOF entries with different IP addresses, removes
+ * the first one and creates another entry in its place.
+ * Expected result: _nib_onl_get() returns the respective entry for all
+ * addresses but the removed one
+ */
+static void test_nib_get__success_reused(void)
+{
+    _nib_onl_entry_t *nodes[GNRC_IPV6_NIB_NUMOF], *node;
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addr, IFACE)));
+        nodes[i]->mode = _NC;
+        addr.u64[1].u64++;
+    }
+    nodes[0]->mode = _EMPTY;
+    TEST_ASSERT(_nib_onl_clear(nodes[0]));
+    TEST_ASSERT_NOT_NULL((node = _nib_onl_alloc(&addr, IFACE)));
+    TEST_ASSERT(nodes[0] == node);
+    node->mode = _NC;
+    TEST_ASSERT(node == _nib_onl_get(&addr, IFACE));
+    TEST_ASSERT(node == _nib_onl_get(&addr, 0));
+    addr.u64[1].u64 = TEST_UINT64;
+    TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE));
+    for (int i = 1; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        addr.u64[1].u64++;
+        TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, IFACE));
+    }
+}
+
 /*
  * Tries to get a NIB entry that is not in the NIB.
  * Expected result: _nib_onl_get() returns NULL
@@ -1929,6 +1961,7 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_get__empty),
         new_TestFixture(test_nib_get__not_in_nib),
         new_TestFixture(test_nib_get__success),
+        new_TestFixture(test_nib_get__success_reused),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_addr),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_iface),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_addr_iface),
@@ -21,9 +21,13 @@
 #include "unittests-constants.h"
 #include "tests-netreg.h"
 
+/* differs from TEST_UINT16 but falls into the same hash bucket */
+#define TEST_UINT16_COLL    (TEST_UINT16 ^ 0x0101)
+
 static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8),
-    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1),
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16_COLL, TEST_UINT8)
 };
 
 static void set_up(void)
@@ -139,6 +143,47 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_lookup_num__empty(void)
+{
+    int num = -1;
+
+    TEST_ASSERT_NULL(gnrc_netreg_lookup_num(GNRC_NETTYPE_TEST, TEST_UINT16, &num));
+    TEST_ASSERT_EQUAL_INT(0, num);
+}
+
+void test_netreg_lookup_num__wrong_type_numof(void)
+{
+    int num = -1;
+
+    TEST_ASSERT_NULL(gnrc_netreg_lookup_num(GNRC_NETTYPE_NUMOF, TEST_UINT16, &num));
+    TEST_ASSERT_EQUAL_INT(0, num);
+}
+
+void test_netreg_lookup_num__same_bucket(void)
+{
+    gnrc_netreg_entry_t *res = NULL;
+    int num = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[2]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup_num(GNRC_NETTYPE_TEST,
+                                                       TEST_UINT16, &num)));
+    TEST_ASSERT_EQUAL_INT(2, num);
+    TEST_ASSERT(&entries[1] == res);
+    TEST_ASSERT(&entries[0] == gnrc_netreg_getnext(res));
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(&entries[0]));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup_num(GNRC_NETTYPE_TEST,
+                                                       TEST_UINT16_COLL, &num)));
+    TEST_ASSERT_EQUAL_INT(1, num);
+    TEST_ASSERT(&entries[2] == res);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &entries[1]);
+    TEST_ASSERT(&entries[0] == gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT(&entries[2] == gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16_COLL));
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +200,9 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_lookup_num__empty),
+        new_TestFixture(test_netreg_lookup_num__wrong_type_numof),
+        new_TestFixture(test_netreg_lookup_num__same_bucket),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -818,6 +818,93 @@ static void test_pktbuf_get_iovec__null(void)
     TEST_ASSERT_EQUAL_INT(0, len);
 }
 
+static void test_pktbuf_get_stats__success(void)
+{
+    gnrc_pktbuf_stats_t stats;
+    gnrc_pktsnip_t *pkt;
+
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.used);
+    TEST_ASSERT_EQUAL_INT(0, stats.allocs);
+    TEST_ASSERT_EQUAL_INT(0, stats.frees);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_stats_snips(&stats, GNRC_NETTYPE_TEST));
+    TEST_ASSERT_NOT_NULL((pkt = gnrc_pktbuf_add(NULL, TEST_STRING16,
+                                                sizeof(TEST_STRING16),
+                                                GNRC_NETTYPE_TEST)));
+    TEST_ASSERT_NOT_NULL(gnrc_pktbuf_mark(pkt, sizeof(TEST_STRING4),
+                                          GNRC_NETTYPE_UNDEF));
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT(stats.used >= (sizeof(TEST_STRING16) + 2 * sizeof(gnrc_pktsnip_t)));
+    TEST_ASSERT(stats.used_peak >= stats.used);
+    TEST_ASSERT(stats.allocs > stats.frees);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_pktbuf_stats_snips(&stats, GNRC_NETTYPE_TEST));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_pktbuf_stats_snips(&stats, GNRC_NETTYPE_UNDEF));
+    gnrc_pktbuf_release(pkt);
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.used);
+    TEST_ASSERT(stats.used_peak >= (sizeof(TEST_STRING16) + 2 * sizeof(gnrc_pktsnip_t)));
+    TEST_ASSERT_EQUAL_INT(stats.allocs, stats.frees);
+    TEST_ASSERT_EQUAL_INT(0, stats.alloc_fails);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_get_stats__realloc(void)
+{
+    gnrc_pktbuf_stats_t stats;
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL((pkt = gnrc_pktbuf_add(NULL, NULL, 256,
+                                                GNRC_NETTYPE_TEST)));
+    /* shrink and grow again */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 64));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 512));
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT(stats.allocs > stats.frees);
+    gnrc_pktbuf_release(pkt);
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.used);
+    TEST_ASSERT_EQUAL_INT(stats.allocs, stats.frees);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#define TEST_PKTS_NUMOF (8U)
+
+static void test_pktbuf_get_stats__alloc_fails(void)
+{
+    gnrc_pktbuf_stats_t stats;
+    gnrc_pktsnip_t *pkts[TEST_PKTS_NUMOF];
+    uint32_t fails_frag;
+
+    for (unsigned i = 0; i < TEST_PKTS_NUMOF; i++) {
+        pkts[i] = gnrc_pktbuf_add(NULL, NULL, (GNRC_PKTBUF_SIZE / 8) - 64,
+                                  GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(pkts[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(ENOMEM, gnrc_pktbuf_realloc_data(pkts[0],
+                                                           GNRC_PKTBUF_SIZE + 1));
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.alloc_fails);
+    TEST_ASSERT_EQUAL_INT(0, stats.alloc_fails_frag);
+    /* punch holes into the packet buffer */
+    for (unsigned i = 1; i < TEST_PKTS_NUMOF; i += 2) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    gnrc_pktbuf_get_stats(&stats);
+    fails_frag = stats.alloc_fails_frag;
+    TEST_ASSERT(stats.largest_free < (GNRC_PKTBUF_SIZE / 4));
+    TEST_ASSERT((GNRC_PKTBUF_SIZE - stats.used) > (GNRC_PKTBUF_SIZE / 4));
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SIZE / 4,
+                                     GNRC_NETTYPE_TEST));
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(fails_frag + 1, stats.alloc_fails_frag);
+    for (unsigned i = 0; i < TEST_PKTS_NUMOF; i += 2) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+
 Test *tests_pktbuf_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -870,6 +957,11 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_get_iovec__1_elem),
         new_TestFixture(test_pktbuf_get_iovec__3_elem),
         new_TestFixture(test_pktbuf_get_iovec__null),
+        new_TestFixture(test_pktbuf_get_stats__success),
+        new_TestFixture(test_pktbuf_get_stats__realloc),
+#ifndef MODULE_GNRC_PKTBUF_MALLOC
+        new_TestFixture(test_pktbuf_get_stats__alloc_fails),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, NULL, fixtures);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for setting and removing timers depending on the
+ *              number of timers set
+ *
+ * xtimer_set() and xtimer_remove() run with interrupts disabled, so their
+ * worst case duration is the worst case interrupt latency they add.
+ * Build with `TEST_HEAP=0` to compare against the sorted timer lists.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "xtimer.h"
+
+#ifndef TEST_TIMERS_MAX
+#define TEST_TIMERS_MAX     (128U)
+#endif
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (256U)
+#endif
+
+/* offsets are chosen so that no timer fires while benchmarking */
+#define TEST_OFFSET_MIN     (10U * US_PER_SEC)
+#define TEST_OFFSET_RANGE   (10U * US_PER_SEC)
+
+static xtimer_t _timers[TEST_TIMERS_MAX];
+static uint32_t _rand_state = 1;
+
+static uint32_t _rand(void)
+{
+    /* simple LCG, good enough to spread the timers */
+    _rand_state = (_rand_state * 1103515245U) + 12345U;
+    return _rand_state >> 8;
+}
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    puts("error: timer fired during benchmark");
+}
+
+static uint32_t _set(xtimer_t *timer)
+{
+    uint32_t offset = TEST_OFFSET_MIN + (_rand() % TEST_OFFSET_RANGE);
+    xtimer_ticks32_t start = xtimer_now();
+
+    xtimer_set(timer, offset);
+    return xtimer_diff(xtimer_now(), start).ticks32;
+}
+
+static uint32_t _remove(xtimer_t *timer)
+{
+    xtimer_ticks32_t start = xtimer_now();
+
+    xtimer_remove(timer);
+    return xtimer_diff(xtimer_now(), start).ticks32;
+}
+
+int main(void)
+{
+    unsigned numof = 0;
+
+#ifdef MODULE_XTIMER_HEAP
+    puts("xtimer benchmark (heap)");
+#else
+    puts("xtimer benchmark (list)");
+#endif
+    for (unsigned i = 0; i < TEST_TIMERS_MAX; i++) {
+        _timers[i].callback = _cb;
+    }
+    for (unsigned n = 8; n <= TEST_TIMERS_MAX; n *= 2) {
+        uint32_t set_max = 0, remove_max = 0;
+
+        while (numof < n) {
+            _set(&_timers[numof++]);
+        }
+        for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+            xtimer_t *timer = &_timers[_rand() % n];
+            uint32_t ticks = _remove(timer);
+
+            remove_max = (ticks > remove_max) ? ticks : remove_max;
+            ticks = _set(timer);
+            set_max = (ticks > set_max) ? ticks : set_max;
+        }
+        printf("%4u timers: set max %" PRIu32 " ticks, remove max %" PRIu32
+               " ticks\n", n, set_max, remove_max);
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        xtimer_remove(&_timers[i]);
+    }
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Counts the wake-ups caused by xtimer for a periodic task
+ *
+ * Build with `TEST_TICKLESS=1` on a board with RTT to compare against the
+ * tickless idle mode.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "xtimer.h"
+
+#ifndef TEST_INTERVAL
+#define TEST_INTERVAL   (1U * US_PER_SEC)
+#endif
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS     (10U)
+#endif
+
+int main(void)
+{
+    xtimer_wakeups_t wakeups;
+    xtimer_ticks32_t last;
+
+#ifdef MODULE_XTIMER_TICKLESS
+    puts("xtimer wake-ups (tickless)");
+#else
+    puts("xtimer wake-ups");
+#endif
+    xtimer_wakeups_reset();
+    last = xtimer_now();
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        xtimer_periodic_wakeup(&last, TEST_INTERVAL);
+    }
+    xtimer_wakeups_get(&wakeups);
+    printf("overflows: %" PRIu32 ", timers: %" PRIu32 ", tickless: %" PRIu32
+           "\n", wakeups.overflows, wakeups.timers, wakeups.tickless);
+    printf("wake-ups per hour: %" PRIu32 "\n",
+           xtimer_wakeups_per_hour(&wakeups));
+    puts("SUCCESS");
+    return 0;
+}